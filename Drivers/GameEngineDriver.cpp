@@ -1,9 +1,15 @@
 #include "GameEngineDriver.h"
 #include "../Models/GameEngine.h"
+#include "../Models/GameLoop.h"
 #include "../Models/Map.h"
 #include "../Models/Player.h"
 #include "../Models/Cards.h"
+#include "../Models/GameRecord.h"
 #include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include "../utils/GameRng.h"
 #include "../utils/logger.h"
 using namespace std;
 
@@ -246,6 +252,145 @@ void testMainGameLoop()
     logMessage(INFO, "Note: For full testing, run the actual mainGameLoop() with proper setup.");
 }
 
+// Snapshot, restore and fork: replaying from a snapshot or playing a fork must
+// reproduce the original game exactly, since both carry the RNG state along
+void testGameSnapshot()
+{
+    cout << "\n=== Testing Game Snapshots ===\n\n";
+    const int RESTORES = 2000;
+
+    GameEngine game;
+    game.buildGraph();
+    game.setSeed(345);
+    GameRngScope rngScope(game.getRng());
+    if (!game.setupGame("Maps/alberta.map", {"Aggressive", "Benevolent", "Cheater"}))
+    {
+        logMessage(ERROR, "Failed to set up the game. Test cannot continue.");
+        return;
+    }
+
+    auto playTurns = [](GameEngine &engine, int turns)
+    {
+        GameRngScope scope(engine.getRng());
+        for (int t = 0; t < turns; t++)
+        {
+            engine.reinforcementPhase();
+            engine.issueOrdersPhase();
+            engine.executeOrdersPhase();
+        }
+    };
+
+    playTurns(game, 2);
+    GameSnapshot midGame = game.snapshot();
+    playTurns(game, 3);
+    GameSnapshot played = game.snapshot();
+    logMessage(INFO, "Snapshot after 2 turns: " + to_string(midGame.owner.size()) + " territories, " +
+                         to_string(midGame.playerCount) + " players, " + to_string(midGame.orders.size()) + " pending orders");
+
+    logMessage(INFO, "--- TEST 1: Restore, then snapshot again ---");
+    if (game.restore(midGame) && game.snapshot() == midGame)
+        logMessage(INFO, "Restored game matches its snapshot correctly");
+    else
+        logMessage(ERROR, "Restored game differs from its snapshot");
+
+    logMessage(INFO, "--- TEST 2: Replay 3 turns from the snapshot ---");
+    playTurns(game, 3);
+    if (game.snapshot() == played)
+        logMessage(INFO, "Replay reached the same state as the original game");
+    else
+        logMessage(ERROR, "Replay diverged from the original game");
+
+    logMessage(INFO, "--- TEST 3: Fork the game and play the fork ---");
+    game.restore(midGame);
+    GameEngine *twin = game.fork();
+    bool forked = twin->snapshot() == midGame;
+    playTurns(*twin, 3);
+    if (forked && twin->snapshot() == played)
+        logMessage(INFO, "Fork played the same game as the original");
+    else
+        logMessage(ERROR, "Fork played a different game");
+    delete twin;
+
+    logMessage(INFO, "--- TEST 4: Damaged snapshots are rejected ---");
+    vector<function<void(GameSnapshot &)>> damage = {
+        [](GameSnapshot &s) { s.reinforcementPool.pop_back(); },
+        [](GameSnapshot &s) { s.conqueredThisTurn.push_back(0); },
+        [](GameSnapshot &s) { s.territoryOffsets.back()++; },
+        [](GameSnapshot &s) { s.handOffsets[1] = s.handOffsets[2] + 1; },
+        [](GameSnapshot &s) { s.orderOffsets.front() = -1; },
+        [](GameSnapshot &s) { s.deck.push_back(static_cast<CardType>(9)); },
+        [](GameSnapshot &s) { s.truces.push_back({0, s.playerCount}); },
+        [](GameSnapshot &s) { s.stateIndex = -7; },
+        [](GameSnapshot &s) { s.orders.push_back(s.orders.empty() ? GameSnapshot::PendingOrder() : s.orders[0]);
+                              s.orders.back().kind = static_cast<OrderKind>(42);
+                              s.orderOffsets.back()++; }};
+    logMessage(INFO, "Each rejected snapshot logs an error");
+    int accepted = 0;
+    for (const function<void(GameSnapshot &)> &apply : damage)
+    {
+        GameSnapshot bad = midGame;
+        apply(bad);
+        if (game.restore(bad) || game.snapshot() != midGame)
+            accepted++;
+    }
+    if (accepted == 0)
+        logMessage(INFO, "All " + to_string(damage.size()) + " damaged snapshots rejected, game left unchanged");
+    else
+        logMessage(ERROR, to_string(accepted) + " of " + to_string(damage.size()) + " damaged snapshots were restored");
+
+    logMessage(INFO, "--- TEST 5: Restore speed ---");
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < RESTORES; i++)
+        game.restore(midGame);
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    logMessage(INFO, to_string(RESTORES) + " restores in " + to_string(elapsed * 1000) + " ms (" +
+                         to_string(static_cast<long>(RESTORES / elapsed)) + " per second)");
+}
+
+// The typed game loop must play the same games as runSingleGame; the benchmark runs
+// both over the same seeds with the console quiet, alternating to share any warm-up
+void testTypedGameLoop()
+{
+    cout << "\n=== Testing Typed Game Loop ===\n\n";
+    const int GAMES = 20;
+    const int MAX_TURNS = 30;
+    const vector<string> strategies = {"Aggressive", "Benevolent", "Neutral", "Cheater"};
+
+    GameEngine engine;
+    ConsoleMode previousMode = getConsoleMode();
+    setConsoleMode(CONSOLE_QUIET);
+
+    double virtualSeconds = 0.0, typedSeconds = 0.0;
+    int mismatches = 0;
+    for (int g = 0; g < GAMES; g++)
+    {
+        auto start = chrono::steady_clock::now();
+        string expected = engine.runSingleGame("Maps/alberta.map", strategies, MAX_TURNS, 77, g);
+        auto middle = chrono::steady_clock::now();
+        string typed = engine.runTypedGame<AggressivePlayerStrategy, BenevolentPlayerStrategy, NeutralPlayerStrategy,
+                                           CheaterPlayerStrategy>("Maps/alberta.map", strategies, MAX_TURNS, 77, g);
+        auto end = chrono::steady_clock::now();
+
+        virtualSeconds += chrono::duration<double>(middle - start).count();
+        typedSeconds += chrono::duration<double>(end - middle).count();
+        if (typed != expected)
+            mismatches++;
+    }
+
+    setConsoleMode(previousMode);
+    flushConsole();
+
+    logMessage(INFO, "--- TEST 1: Same games with both dispatch policies ---");
+    if (mismatches == 0)
+        logMessage(INFO, "Typed loop played all " + to_string(GAMES) + " games to the same winner correctly");
+    else
+        logMessage(ERROR, "Typed loop changed the winner of " + to_string(mismatches) + " of " + to_string(GAMES) + " games");
+
+    logMessage(INFO, "--- TEST 2: Games per second ---");
+    logMessage(INFO, "Virtual dispatch: " + to_string(GAMES / virtualSeconds) + " games/s");
+    logMessage(INFO, "Typed dispatch: " + to_string(GAMES / typedSeconds) + " games/s (" + to_string(virtualSeconds / typedSeconds) + "x)");
+}
+
 /*
 int main()
 {
@@ -256,3 +401,359 @@ int main()
     return 0;
 }
 */
+
+// A recorded game, written out and read back, must rebuild the exact state of every
+// turn; seeking replays the events instead of the strategies and battles
+void testGameReplay()
+{
+    cout << "\n=== Testing Game Recording and Replay ===\n\n";
+    const int TURNS = 12;
+    const int SEEKS = 200;
+    const string FILE = "replay_test.wzr";
+
+    GameEngine game;
+    game.buildGraph();
+    game.setSeed(345);
+    GameRngScope rngScope(game.getRng());
+    if (!game.setupGame("Maps/alberta.map", {"Aggressive", "Benevolent", "Cheater"}))
+    {
+        logMessage(ERROR, "Failed to set up the game. Test cannot continue.");
+        return;
+    }
+
+    ConsoleMode previousMode = getConsoleMode();
+    setConsoleMode(CONSOLE_QUIET);
+
+    GameRecorder recorder;
+    vector<GameSnapshot> turns;
+    GameSnapshot start = game.snapshot();
+    turns.push_back(start);
+    auto playStart = chrono::steady_clock::now();
+    {
+        recorder.begin(game, "Maps/alberta.map", 345, 0);
+        GameRecorderScope recording(&recorder);
+        for (int t = 0; t < TURNS; t++)
+        {
+            game.reinforcementPhase();
+            game.issueOrdersPhase();
+            game.executeOrdersPhase();
+            turns.push_back(game.snapshot());
+        }
+        recorder.finish(nullptr);
+    }
+    double playSeconds = chrono::duration<double>(chrono::steady_clock::now() - playStart).count();
+
+    vector<GameRecording> loaded;
+    RecordingWriter(FILE).write(recorder.getRecording());
+    bool readBack = readRecordings(FILE, loaded) && loaded.size() == 1 &&
+                    loaded[0].events.size() == recorder.getRecording().events.size();
+    remove(FILE.c_str());
+
+    bool matches = readBack;
+    double seekSeconds = 0.0;
+    if (readBack)
+    {
+        ReplayEngine replay(loaded[0]);
+        matches = replay.isReady();
+        for (int t = 0; matches && t <= TURNS; t++)
+            matches = replay.seekTurn(t) && replay.getEngine().snapshot() == turns[t];
+        // backwards and skipping ahead
+        for (int t : {3, 0, TURNS, 7})
+            matches = matches && replay.seekTurn(t) && replay.getEngine().snapshot() == turns[t];
+
+        auto seekStart = chrono::steady_clock::now();
+        for (int i = 0; i < SEEKS; i++)
+            replay.seekTurn(i % 2 ? TURNS : 0);
+        seekSeconds = chrono::duration<double>(chrono::steady_clock::now() - seekStart).count() / SEEKS;
+    }
+
+    // A damaged start snapshot must fail the read, a damaged keyframe the replay setup
+    GameRecording damaged = recorder.getRecording();
+    GameSnapshot badState = damaged.start;
+    badState.handOffsets.back() += 1000;
+    damaged.start.orderOffsets.front() = -3;
+    vector<GameRecording> rejected;
+    RecordingWriter(FILE).write(damaged);
+    bool badRead = readRecordings(FILE, rejected);
+    remove(FILE.c_str());
+    damaged = recorder.getRecording();
+    damaged.keyframes.push_back({1, 0, badState});
+    bool badReplay = ReplayEngine(damaged).isReady();
+
+    setConsoleMode(previousMode);
+    flushConsole();
+    const GameRecording &recording = recorder.getRecording();
+    logMessage(INFO, to_string(recording.turnCount()) + " turns recorded as " + to_string(recording.events.size()) +
+                         " events (" + to_string(recording.events.size() * sizeof(ReplayEvent)) + " bytes)");
+
+    logMessage(INFO, "--- TEST 1: Write the recording and read it back ---");
+    if (readBack)
+        logMessage(INFO, "Recording read back with every event correctly");
+    else
+        logMessage(ERROR, "Recording could not be read back from " + FILE);
+
+    logMessage(INFO, "--- TEST 2: Seek the replay to every turn ---");
+    if (matches)
+        logMessage(INFO, "Replay matched the played game at every turn, forwards and backwards");
+    else
+        logMessage(ERROR, "Replay differs from the played game");
+    logMessage(INFO, "Playing " + to_string(TURNS) + " turns: " + to_string(playSeconds * 1000) +
+                         " ms, seeking to a turn: " + to_string(seekSeconds * 1000) + " ms");
+
+    logMessage(INFO, "--- TEST 3: Damaged recordings are refused ---");
+    if (!badRead && !badReplay)
+        logMessage(INFO, "Bad offsets rejected by the reader and by the replay correctly");
+    else
+        logMessage(ERROR, string("Damaged recording accepted by the ") + (badRead ? "reader" : "replay"));
+}
+
+// Seeking deep into a long game: loading through the file index starts from the nearest
+// keyframe, so it must reach the same state as replaying every event from the start
+void testReplayKeyframes()
+{
+    cout << "\n=== Testing Replay Keyframes ===\n\n";
+    const int TURNS = 400;
+    const int INTERVAL = 25;
+    const int TARGET = 390;
+    const int SEEKS = 50;
+    const string FILE = "keyframe_test.wzr";
+
+    GameEngine game;
+    game.buildGraph();
+    game.setSeed(2024);
+    GameRngScope rngScope(game.getRng());
+    if (!game.setupGame("Maps/alberta.map", {"Aggressive", "Benevolent", "Neutral"}))
+    {
+        logMessage(ERROR, "Failed to set up the game. Test cannot continue.");
+        return;
+    }
+
+    ConsoleMode previousMode = getConsoleMode();
+    setConsoleMode(CONSOLE_QUIET);
+
+    GameRecorder recorder;
+    recorder.setKeyframeInterval(INTERVAL);
+    GameSnapshot expected;
+    {
+        recorder.begin(game, "Maps/alberta.map", 2024, 0);
+        GameRecorderScope recording(&recorder);
+        for (int t = 1; t <= TURNS; t++)
+        {
+            game.reinforcementPhase();
+            game.issueOrdersPhase();
+            game.executeOrdersPhase();
+            if (t == TARGET)
+                expected = game.snapshot();
+        }
+        recorder.finish(nullptr);
+    }
+    RecordingWriter(FILE).write(recorder.getRecording());
+
+    RecordingFile file;
+    GameRecording partial;
+    bool indexed = file.open(FILE) && file.gameCount() == 1 && file.load(0, TARGET, partial);
+    vector<GameRecording> full;
+    bool readBack = readRecordings(FILE, full) && full.size() == 1;
+    remove(FILE.c_str());
+
+    bool fromKeyframe = false, fromStart = false;
+    double keyframeSeconds = 0.0, startSeconds = 0.0;
+    if (indexed && readBack)
+    {
+        ReplayEngine partialReplay(partial);
+        fromKeyframe = partialReplay.isReady() && partialReplay.seekTurn(TARGET) &&
+                       partialReplay.getEngine().snapshot() == expected;
+
+        ReplayEngine keyframed(full[0]);
+        GameRecording bare = full[0];
+        bare.keyframes.clear();
+        ReplayEngine unindexed(bare);
+        fromStart = unindexed.seekTurn(TARGET) && unindexed.getEngine().snapshot() == expected &&
+                    keyframed.seekTurn(TARGET) && keyframed.getEngine().snapshot() == expected;
+
+        auto timeSeeks = [&](ReplayEngine &replay)
+        {
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < SEEKS; i++)
+            {
+                replay.seekTurn(TURNS);
+                replay.seekTurn(TARGET); // backwards: starts over from a keyframe or the start
+            }
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count() / SEEKS;
+        };
+        keyframeSeconds = timeSeeks(keyframed);
+        startSeconds = timeSeeks(unindexed);
+    }
+
+    setConsoleMode(previousMode);
+    flushConsole();
+    logMessage(INFO, to_string(TURNS) + " turns recorded with " + to_string(recorder.getRecording().keyframes.size()) +
+                         " keyframes and " + to_string(recorder.getRecording().events.size()) + " events");
+
+    logMessage(INFO, "--- TEST 1: Load turn " + to_string(TARGET) + " through the file index ---");
+    if (fromKeyframe)
+        logMessage(INFO, "Loaded from keyframe " + to_string(partial.startTurn) + " plus " +
+                             to_string(partial.events.size()) + " events, state matched correctly");
+    else
+        logMessage(ERROR, "Loading through the index did not reach the played state");
+
+    logMessage(INFO, "--- TEST 2: Replay every event from the start ---");
+    if (fromStart)
+        logMessage(INFO, "Full replay reached the same state as the keyframe");
+    else
+        logMessage(ERROR, "Full replay did not reach the played state");
+    logMessage(INFO, "Seek back to turn " + to_string(TARGET) + ": " + to_string(keyframeSeconds * 1000) +
+                         " ms with keyframes, " + to_string(startSeconds * 1000) + " ms without (restores included)");
+}
+
+// Early draws: a game with no attacker stalls and must be called within the window, a
+// game where territories keep changing hands must not be, and a disabled rule never fires
+void testStalemateDetection()
+{
+    cout << "\n=== Testing Stalemate Detection ===\n\n";
+    const int MAX_TURNS = 100;
+    StalemateRule rule;
+    rule.window = 10;
+    rule.repeats = 5;
+
+    ConsoleMode previousMode = getConsoleMode();
+    setConsoleMode(CONSOLE_QUIET);
+
+    // Turns until the rule fires (MAX_TURNS + 1 if it never does)
+    auto turnsUntilDraw = [&](const vector<string> &strategies, const StalemateRule &gameRule, string &reason)
+    {
+        GameEngine game;
+        game.buildGraph();
+        game.setSeed(99);
+        GameRngScope rngScope(game.getRng());
+        if (!game.setupGame("Maps/alberta.map", strategies))
+            return -1;
+        StalemateDetector detector(gameRule);
+        for (int turn = 1; turn <= MAX_TURNS; turn++)
+        {
+            game.reinforcementPhase();
+            game.issueOrdersPhase();
+            game.executeOrdersPhase();
+            if (detector.endTurn(game, turn))
+            {
+                reason = detector.getReason();
+                return turn;
+            }
+        }
+        return MAX_TURNS + 1;
+    };
+
+    string stalledReason, cheaterReason, offReason;
+    int stalled = turnsUntilDraw({"Benevolent", "Neutral"}, rule, stalledReason);
+    int cheater = turnsUntilDraw({"Cheater", "Benevolent", "Neutral"}, rule, cheaterReason);
+    int off = turnsUntilDraw({"Benevolent", "Neutral"}, StalemateRule(), offReason);
+
+    setConsoleMode(previousMode);
+    flushConsole();
+
+    logMessage(INFO, "--- TEST 1: Benevolent vs Neutral, no one attacks ---");
+    if (stalled > 0 && stalled <= rule.window + 1)
+        logMessage(INFO, "Drawn at turn " + to_string(stalled) + " (" + stalledReason + ") correctly");
+    else
+        logMessage(ERROR, "Stalled game was not drawn within " + to_string(rule.window + 1) + " turns");
+
+    logMessage(INFO, "--- TEST 2: Cheater conquering every turn ---");
+    if (cheater > 3)
+        logMessage(INFO, "Game kept going while territories changed hands");
+    else
+        logMessage(ERROR, "Game was drawn at turn " + to_string(cheater) + " (" + cheaterReason + ")");
+
+    logMessage(INFO, "--- TEST 3: Rule turned off ---");
+    if (off == MAX_TURNS + 1)
+        logMessage(INFO, "No draw in " + to_string(MAX_TURNS) + " turns");
+    else
+        logMessage(ERROR, "Disabled rule drew the game (" + offReason + ")");
+}
+
+// Fast-forward: proven forecasts must name the winner and the last turn the full game
+// reaches, and a game no one can win is called a draw straight away
+void testFastForward()
+{
+    cout << "\n=== Testing Fast-Forward ===\n\n";
+    const int MAX_TURNS = 60;
+    FastForwardRule rule;
+    rule.enabled = true;
+
+    ConsoleMode previousMode = getConsoleMode();
+    setConsoleMode(CONSOLE_QUIET);
+
+    // Forecast after turn 1, then play on until one player is left: true if both agree
+    auto forecastHolds = [&](const vector<string> &strategies, uint64_t seed, Forecast &forecast)
+    {
+        GameEngine game;
+        game.buildGraph();
+        game.setSeed(seed);
+        GameRngScope rngScope(game.getRng());
+        if (!game.setupGame("Maps/alberta.map", strategies))
+            return false;
+        OutcomeForecaster forecaster(rule);
+        Player *winner = nullptr;
+        int endTurn = MAX_TURNS;
+        for (int turn = 1; turn <= MAX_TURNS && !winner; turn++)
+        {
+            game.reinforcementPhase();
+            game.issueOrdersPhase();
+            game.executeOrdersPhase();
+            if (turn == 1)
+                forecast = forecaster.forecast(game, turn, MAX_TURNS);
+            Player *owner = nullptr;
+            int owners = 0;
+            for (Player *player : game.getPlayers())
+            {
+                if (!player->getTerritories().empty())
+                {
+                    owner = player;
+                    owners++;
+                }
+            }
+            if (owners == 1)
+            {
+                winner = owner;
+                endTurn = turn;
+            }
+        }
+        return forecast.decided && forecast.winner == winner && forecast.endTurn == endTurn;
+    };
+
+    bool cheaterHolds = true;
+    int cheaterEnd = 0;
+    for (uint64_t seed = 1; seed <= 5; seed++)
+    {
+        Forecast forecast;
+        cheaterHolds = forecastHolds({"Cheater", "Neutral", "Neutral"}, seed, forecast) && cheaterHolds;
+        cheaterEnd = forecast.endTurn;
+    }
+    Forecast passive;
+    bool passiveHolds = forecastHolds({"Benevolent", "Neutral"}, 7, passive);
+
+    // Off by default: the engine plays every turn
+    GameEngine engine;
+    engine.buildGraph();
+    bool offByDefault = !engine.getFastForwardRule().enabled;
+
+    setConsoleMode(previousMode);
+    flushConsole();
+
+    logMessage(INFO, "--- TEST 1: Cheater vs Neutral, 5 seeds ---");
+    if (cheaterHolds)
+        logMessage(INFO, "Forecast named the winner and the last turn (" + to_string(cheaterEnd) + ") correctly");
+    else
+        logMessage(ERROR, "Forecast disagreed with the full game");
+
+    logMessage(INFO, "--- TEST 2: Benevolent vs Neutral ---");
+    if (passiveHolds && !passive.winner)
+        logMessage(INFO, "Forecast as a draw (" + passive.basis + ")");
+    else
+        logMessage(ERROR, "Game with no attacker was not forecast as a draw");
+
+    logMessage(INFO, "--- TEST 3: Default rule ---");
+    if (offByDefault)
+        logMessage(INFO, "Fast-forward is off by default");
+    else
+        logMessage(ERROR, "Fast-forward is on by default");
+}
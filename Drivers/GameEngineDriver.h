@@ -4,5 +4,11 @@
 void testStartupPhase();
 void testGameStates();
 void testMainGameLoop();
+void testGameSnapshot();
+void testTypedGameLoop();
+void testGameReplay();
+void testReplayKeyframes();
+void testStalemateDetection();
+void testFastForward();
 
 #endif // GAME_ENGINE_DRIVER_H
\ No newline at end of file
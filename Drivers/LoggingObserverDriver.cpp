@@ -1,6 +1,10 @@
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <thread>
+#include "LoggingObserverDriver.h"
 #include "../utils/LoggingObserver.h"
+#include "../Models/Cards.h"
 #include "../Models/CommandProcessing.h"
 #include "../Models/Orders.h"
 #include "../Models/GameEngine.h"
@@ -102,6 +106,95 @@ void testLoggingObserver()
     std::cout << "Check Logs/GameLogs.txt for results." << std::endl;
 }
 
+// Counts what reaches it
+class CountingObserver : public Observer
+{
+public:
+    int updates = 0;
+    void Update(ILoggable *, LogLevel, const std::string &) override { updates++; }
+};
+
+// Counts what reaches it from any thread
+class SharedCountingObserver : public Observer
+{
+public:
+    std::atomic<long> updates{0};
+    void Update(ILoggable *, LogLevel, const std::string &) override { updates++; }
+};
+
+// Subscriptions by level and category: an observer only hears what it asked for,
+// and with no one taking a level, Notify returns before touching any list
+void testObserverRegistry()
+{
+    std::cout << "\n=== Testing Observer Registry ===\n" << std::endl;
+    LogObserver *logger = LogObserver::getInstance();
+    CountingObserver counter;
+    ObserverRegistry::subscribe(&counter, levelBit(COMBAT), categoryBit(SUBJECT_ORDER));
+
+    logMessage(INFO, "--- TEST 1: Observer subscribed to COMBAT from orders ---");
+    Deploy order;
+    Deck deck;
+    order.Notify(&order, COMBAT, "order combat");
+    order.Notify(&order, INFO, "order info");
+    deck.Notify(&deck, COMBAT, "deck combat");
+    if (counter.updates == 1)
+        logMessage(INFO, "Only the order's COMBAT message reached the observer correctly");
+    else
+        logMessage(ERROR, "Observer received " + to_string(counter.updates) + " messages instead of 1");
+
+    logMessage(INFO, "--- TEST 2: Unsubscribe ---");
+    ObserverRegistry::unsubscribe(&counter);
+    order.Notify(&order, COMBAT, "after unsubscribe");
+    if (counter.updates == 1)
+        logMessage(INFO, "Nothing reached the observer after unsubscribing");
+    else
+        logMessage(ERROR, "Observer still received messages after unsubscribing");
+
+    logMessage(INFO, "--- TEST 3: No subscriber left ---");
+    ObserverRegistry::unsubscribe(logger);
+    bool silent = !ObserverRegistry::wants(DEBUG) && !ObserverRegistry::wants(ERROR);
+    ObserverRegistry::subscribe(logger);
+    if (silent && ObserverRegistry::wants(DEBUG))
+        logMessage(INFO, "No level was wanted until the logger subscribed again");
+    else
+        logMessage(ERROR, "Levels were still wanted with no subscriber");
+
+    logMessage(INFO, "--- TEST 4: Delete observers while other threads notify ---");
+    const int THREADS = 4;
+    const int ROUNDS = 50;
+    ObserverRegistry::unsubscribe(logger); // keep the workers' messages out of the log
+    SharedCountingObserver steady;
+    ObserverRegistry::subscribe(&steady, levelBit(COMBAT), categoryBit(SUBJECT_ORDER));
+    std::atomic<bool> done{false};
+    std::vector<std::thread> notifiers;
+    for (int t = 0; t < THREADS; t++)
+        notifiers.emplace_back([&]
+                               { while (!done.load()) order.Notify(&order, COMBAT, "from a worker"); });
+    long reached = 0;
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        SharedCountingObserver *dropped = new SharedCountingObserver();
+        ObserverRegistry::subscribe(dropped, levelBit(COMBAT), categoryBit(SUBJECT_ORDER));
+        std::this_thread::yield();
+        ObserverRegistry::unsubscribe(dropped);
+        ObserverRegistry::quiesce(); // nothing is inside dropped->Update past this point
+        reached += dropped->updates.load();
+        delete dropped;
+    }
+    done.store(true);
+    for (std::thread &notifier : notifiers)
+        notifier.join();
+    ObserverRegistry::unsubscribe(&steady);
+    ObserverRegistry::quiesce();
+    ObserverRegistry::subscribe(logger);
+    if (steady.updates.load() > 0)
+        logMessage(INFO, to_string(ROUNDS) + " observers deleted after quiesce while " + to_string(THREADS) +
+                             " threads notified (" + to_string(steady.updates.load()) + " messages, " +
+                             to_string(reached) + " to the deleted ones)");
+    else
+        logMessage(ERROR, "No message reached the observers from the notifying threads");
+}
+
 /*
 int main()
 {
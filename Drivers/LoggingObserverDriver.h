@@ -2,5 +2,6 @@
 #define LOGGINGOBSERVERDRIVER_H
 
 void testLoggingObserver();
+void testObserverRegistry();
 
 #endif
\ No newline at end of file
@@ -1,9 +1,16 @@
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include "OrdersDriver.h"
 #include "../Models/Orders.h"
 #include "../Models/Player.h"
 #include "../Models/Map.h"
 #include "../Models/GameEngine.h"
 #include "../Models/Cards.h"
+#include "../Models/CompactOrder.h"
+#include "../utils/GameRng.h"
+#include "../utils/logger.h"
 using namespace std;
 
 const string MOCK_PLAYER_NAME_1 = "n00b69";
@@ -55,6 +62,8 @@ void testOrderExecution()
 
     player1->setId(1);
     player2->setId(2);
+    engine->addPlayer(player1); // truces are kept by player slot
+    engine->addPlayer(player2);
     player1->setReinforcementPool(50);
     player2->setReinforcementPool(50);
 
@@ -145,7 +154,7 @@ void testOrderExecution()
     cout << "Before airlift - Armies in t1: " << t1->getArmies() << ", t3: " << t3->getArmies() << endl;
 
     // Reset t3 ownership to player1 for airlift test
-    t3->setOwner(player1);
+    Player::transferTerritory(t3, player1);
     Airlift airlift(player1, t1, t3, 4);
     airlift.execute();
     cout << "Effect: " << airlift.getEffect() << endl;
@@ -187,10 +196,8 @@ void testOrderExecution()
     ordersList.remove(1);
     ordersList.print();
 
-    // Cleanup
+    // Cleanup (the engine deletes the players)
     delete engine;
-    delete player1;
-    delete player2;
     delete t1;
     delete t2;
     delete t3;
@@ -199,6 +206,336 @@ void testOrderExecution()
     cout << "\nAll Order Execution Tests Complete" << endl;
 }
 
+// Sample mean and variance of one battle statistic over many trials
+struct BattleSample
+{
+    double sum = 0;
+    double sumSq = 0;
+    void add(double x)
+    {
+        sum += x;
+        sumSq += x * x;
+    }
+    double mean(int n) const { return sum / n; }
+    double variance(int n) const { return (sumSq - sum * sum / n) / (n - 1); }
+};
+
+// z statistic for the difference of two sample means (Welch)
+static double welchZ(const BattleSample &a, const BattleSample &b, int n)
+{
+    double se = std::sqrt(a.variance(n) / n + b.variance(n) / n);
+    if (se == 0)
+        return a.mean(n) == b.mean(n) ? 0.0 : 1e9;
+    return (a.mean(n) - b.mean(n)) / se;
+}
+
+// Statistical equivalence of the binomial combat kernel and the per-army reference loop:
+// for several stack sizes, the attacker win rate and the mean survivors on both sides
+// must agree within |z| < 4 over many independent battles.
+void testCombatKernel()
+{
+    cout << "\n=== Testing Combat Kernel ===\n\n";
+    const int TRIALS = 20000;
+    const double Z_LIMIT = 4.0;
+    const int cases[][2] = {{1, 1}, {3, 2}, {5, 5}, {10, 8}, {9, 11}, {40, 30}};
+
+    GameRng rng(345);
+    bool allPassed = true;
+    logMessage(INFO, "Fighting " + to_string(TRIALS) + " battles per case with both kernels (win rate / attackers left / defenders left)...");
+
+    for (const auto &c : cases)
+    {
+        BattleSample fastWins, refWins, fastAtk, refAtk, fastDef, refDef;
+        for (int t = 0; t < TRIALS; ++t)
+        {
+            BattleResult fast = resolveBattle(c[0], c[1], rng);
+            BattleResult ref = resolveBattlePerArmy(c[0], c[1], rng);
+            fastWins.add(fast.defenders == 0 && fast.attackers > 0);
+            refWins.add(ref.defenders == 0 && ref.attackers > 0);
+            fastAtk.add(fast.attackers);
+            refAtk.add(ref.attackers);
+            fastDef.add(fast.defenders);
+            refDef.add(ref.defenders);
+        }
+
+        double zWins = welchZ(fastWins, refWins, TRIALS);
+        double zAtk = welchZ(fastAtk, refAtk, TRIALS);
+        double zDef = welchZ(fastDef, refDef, TRIALS);
+        bool passed = std::fabs(zWins) < Z_LIMIT && std::fabs(zAtk) < Z_LIMIT && std::fabs(zDef) < Z_LIMIT;
+        allPassed &= passed;
+
+        ostringstream line;
+        line << c[0] << " vs " << c[1] << ": binomial " << fastWins.mean(TRIALS) << " / " << fastAtk.mean(TRIALS)
+             << " / " << fastDef.mean(TRIALS) << ", per army " << refWins.mean(TRIALS) << " / " << refAtk.mean(TRIALS)
+             << " / " << refDef.mean(TRIALS) << " (z = " << zWins << ", " << zAtk << ", " << zDef << ")";
+        logMessage(passed ? INFO : ERROR, line.str());
+    }
+
+    // Huge stacks, as produced by the Cheater's army doubling
+    auto start = std::chrono::steady_clock::now();
+    BattleResult big = resolveBattle(50000000, 40000000, rng);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    logMessage(INFO, "50000000 vs 40000000: " + to_string(big.rounds) + " rounds, " + to_string(big.attackers) +
+                         " attackers left in " + to_string(static_cast<int>(elapsed)) + " ms");
+
+    if (allPassed)
+        logMessage(INFO, "Both kernels give the same battle statistics (|z| < 4 in every case)");
+    else
+        logMessage(ERROR, "The binomial kernel's statistics differ from the per-army reference");
+}
+
+// Executes every queued order the way executeOrdersPhase does: all deploys round-robin,
+// then all other orders round-robin. Players without territories are skipped.
+static void executeQueuedOrders(GameEngine &engine)
+{
+    GameRngScope scope(engine.getRng());
+    const vector<Player *> &players = engine.getPlayers();
+    for (bool deploys : {true, false})
+    {
+        bool ran = true;
+        while (ran)
+        {
+            ran = false;
+            for (Player *player : players)
+            {
+                OrdersList *list = player->getOrdersList();
+                Order *order = deploys ? list->nextDeploy() : list->nextOther();
+                if (player->getTerritories().empty() || !order)
+                    continue;
+                order->execute();
+                deploys ? list->popDeploy() : list->popOther();
+                ran = true;
+            }
+        }
+    }
+    for (Player *player : players)
+        player->getOrdersList()->clear();
+}
+
+// Snapshots store pending orders as CompactOrders, and restore (so fork too) rebuilds the
+// Order objects from them. Each turn a random mix of orders of every kind (valid or not)
+// is queued; a fork must hold the same orders and play the turn to the same state.
+void testCompactOrders()
+{
+    cout << "\n=== Testing Compact Orders ===\n\n";
+    logMessage(INFO, "sizeof(Advance) = " + to_string(sizeof(Advance)) + ", sizeof(CompactOrder) = " + to_string(sizeof(CompactOrder)));
+
+    GameEngine game;
+    game.buildGraph();
+    game.setSeed(23);
+    GameRngScope rngScope(game.getRng());
+    if (!game.setupGame("Maps/alberta.map", {"Aggressive", "Benevolent", "Neutral", "Cheater"}))
+    {
+        logMessage(ERROR, "Failed to set up the game. Test cannot continue.");
+        return;
+    }
+    Map *map = game.getMap();
+    GameRng testRng(91);
+    auto pick = [&](int n) { return uniform_int_distribution<int>(0, n - 1)(testRng); };
+    const OrderKind kinds[] = {OrderKind::Deploy, OrderKind::Advance, OrderKind::Bomb,
+                               OrderKind::Blockade, OrderKind::Airlift, OrderKind::Negotiate};
+
+    logMessage(INFO, "--- TEST 1: The neutral slot before there is a neutral player ---");
+    OrderContext context(game);
+    int neutralSlot = static_cast<int>(game.getPlayers().size());
+    if (!context.player(neutralSlot) && !game.snapshot().hasNeutral)
+        logMessage(INFO, "Neutral slot resolved to no player, none was created");
+    else
+        logMessage(ERROR, "Looking up the neutral slot created a neutral player");
+
+    const int TURNS = 12;
+    int sameOrders = 0, samePlay = 0, orders = 0;
+    for (int turn = 1; turn <= TURNS; turn++)
+    {
+        const vector<Player *> &players = game.getPlayers();
+        for (int id = 0; id < map->getTerritoriesSize(); id++)
+            map->getTerritoryById(id)->setArmies(1 + pick(12));
+        for (Player *player : players)
+        {
+            player->setReinforcementPool(pick(20));
+            Span<Territory *> owned = player->getTerritories();
+            for (int i = 0; i < 8 && !owned.empty(); i++)
+            {
+                OrderParams params;
+                params.issuer = player;
+                params.source = owned[pick(static_cast<int>(owned.size()))];
+                TerritoryRange neighbors = map->neighborsOf(params.source);
+                params.target = neighbors.size() && pick(4) ? neighbors[pick(static_cast<int>(neighbors.size()))]
+                                                            : map->getTerritoryById(pick(map->getTerritoriesSize()));
+                params.other = players[pick(static_cast<int>(players.size()))];
+                params.armies = pick(15);
+                player->getOrdersList()->add(Order::create(kinds[pick(6)], params, map, &game));
+                orders++;
+            }
+        }
+
+        // The fork's orders were rebuilt from their compact form: they must compact the same
+        GameEngine *twin = game.fork();
+        OrderContext twinContext(*twin);
+        bool same = twin->getPlayers().size() == players.size();
+        for (size_t p = 0; same && p < players.size(); p++)
+        {
+            OrdersList *list = players[p]->getOrdersList();
+            OrdersList *twinList = twin->getPlayers()[p]->getOrdersList();
+            same = list->size() == twinList->size();
+            for (size_t i = 0; same && i < list->size(); i++)
+                same = context.compact(*list->get(static_cast<int>(i))) == twinContext.compact(*twinList->get(static_cast<int>(i)));
+        }
+        sameOrders += same;
+
+        executeQueuedOrders(*twin);
+        executeQueuedOrders(game);
+        samePlay += twin->snapshot() == game.snapshot();
+        delete twin;
+    }
+    logMessage(INFO, to_string(orders) + " random orders queued over " + to_string(TURNS) + " turns");
+
+    logMessage(INFO, "--- TEST 2: Forked orders, rebuilt from CompactOrders ---");
+    if (sameOrders == TURNS)
+        logMessage(INFO, "Every forked order compacted to the original's CompactOrder correctly");
+    else
+        logMessage(ERROR, "Forked orders differ in " + to_string(TURNS - sameOrders) + " of " + to_string(TURNS) + " turns");
+
+    logMessage(INFO, "--- TEST 3: Forks play the queued orders ---");
+    if (samePlay == TURNS)
+        logMessage(INFO, "Fork and game ended every turn in the same state");
+    else
+        logMessage(ERROR, "Fork and game diverged in " + to_string(TURNS - samePlay) + " of " + to_string(TURNS) + " turns");
+}
+
+// Orders keep their effect as an OrderOutcome; the text is rendered from it on demand and
+// must read as before. Each case checks the recorded numbers and the rendered text.
+void testOrderEffects()
+{
+    cout << "\n=== Testing Order Effects ===\n\n";
+    GameEngine engine;
+    GameRngScope rngScope(engine.getRng());
+    Player *attacker = new Player("Attacker");
+    Player *defender = new Player("Defender");
+    attacker->setReinforcementPool(10);
+
+    Territory alpha("Alpha", 1, 1), beta("Beta", 2, 1), gamma("Gamma", 3, 1);
+    alpha.addAdjacentTerritory(2);
+    alpha.addAdjacentTerritory(3);
+    beta.addAdjacentTerritory(1);
+    gamma.addAdjacentTerritory(1);
+    alpha.setOwner(attacker);
+    gamma.setOwner(attacker);
+    beta.setOwner(defender);
+    attacker->addTerritory(&alpha);
+    attacker->addTerritory(&gamma);
+    defender->addTerritory(&beta);
+    alpha.setArmies(20);
+    beta.setArmies(1);
+    gamma.setArmies(4);
+
+    int test = 0;
+    auto check = [&](const string &name, bool passed, const Order &order)
+    {
+        logMessage(INFO, "--- TEST " + to_string(++test) + ": " + name + " ---");
+        if (passed)
+            logMessage(INFO, "Outcome and text read correctly: " + order.getEffect());
+        else
+            logMessage(ERROR, "Unexpected outcome or text: " + order.getEffect());
+    };
+
+    Deploy pending(attacker, &alpha, 3);
+    check("Not executed", pending.getOutcome().result == OrderResult::NotExecuted && pending.getEffect() == "None", pending);
+
+    Deploy deploy(attacker, &alpha, 4);
+    deploy.execute();
+    const OrderOutcome &deployed = deploy.getOutcome();
+    check("Deploy", deployed.result == OrderResult::Deployed && deployed.armies == 4 && deployed.target == 1 &&
+                        deploy.getEffect() == "Deployed 4 to Alpha",
+          deploy);
+
+    Advance move(attacker, &alpha, &gamma, 2);
+    move.execute();
+    check("Friendly advance", move.getOutcome().result == OrderResult::Moved && !move.isExecuted() &&
+                                  move.getEffect() == "Moved 2 to defend Gamma",
+          move);
+
+    Advance attack(attacker, &alpha, &beta, 15);
+    attack.execute();
+    const OrderOutcome &battle = attack.getOutcome();
+    string expected = battle.result == OrderResult::Conquered
+                          ? "Conquered Beta with " + to_string(battle.attackersLeft) + " survivors."
+                          : "Attack ended. Defender left " + to_string(battle.defendersLeft) + ", attackers left " +
+                                to_string(battle.attackersLeft) + ".";
+    check("Attack", battle.battle() && battle.source == 1 && battle.target == 2 && attack.getEffect() == expected,
+          attack);
+
+    Airlift badAirlift(defender, &alpha, &gamma, 1);
+    badAirlift.execute();
+    check("Invalid airlift", badAirlift.getOutcome().result == OrderResult::Invalid &&
+                                 badAirlift.getEffect() == "Invalid: source/target must both be owned by issuer.",
+          badAirlift);
+
+    Negotiate negotiate(attacker, defender, &engine);
+    negotiate.execute();
+    Order *copy = negotiate.clone();
+    check("Cloned negotiate", copy->getOutcome().result == OrderResult::Negotiated &&
+                                  copy->getEffect() == negotiate.getEffect(),
+          *copy);
+    delete copy;
+
+    delete attacker;
+    delete defender;
+}
+
+// Truces are kept by player slot. Tournament players all have id -1, like the neutral
+// player, so they must still be told apart; an eliminated player's truces go with it.
+void testTruces()
+{
+    cout << "\n=== Testing Truces ===\n\n";
+    GameEngine game;
+    if (!game.setupGame("Maps/alberta.map", {"Aggressive", "Benevolent", "Neutral", "Cheater"}))
+    {
+        logMessage(ERROR, "Failed to set up the game. Test cannot continue.");
+        return;
+    }
+    const vector<Player *> &players = game.getPlayers();
+    Player *neutral = game.getNeutralPlayer();
+
+    int test = 0;
+    auto check = [&](const string &name, bool passed)
+    {
+        logMessage(INFO, "--- TEST " + to_string(++test) + ": " + name + " ---");
+        if (passed)
+            logMessage(INFO, name + " handled correctly");
+        else
+            logMessage(ERROR, name + " check failed");
+    };
+
+    game.addTruce(players[0], neutral);
+    game.addTruce(players[3], players[1]);
+    check("Truce with the neutral player", game.isTruced(neutral, players[0]) && !game.isTruced(players[2], neutral));
+    check("Truce between players", game.isTruced(players[1], players[3]) && !game.isTruced(players[0], players[1]));
+    check("Slot pairs", game.snapshot().truces == (vector<pair<int, int>>{{0, 4}, {1, 3}}));
+
+    TruceMatrix matrix;
+    matrix.add(0, 4);
+    matrix.add(1, 3);
+    matrix.add(2, 3);
+    matrix.removeSlot(1); // slots 2, 3 and 4 move down by one
+    check("Eliminated slot", matrix.pairs() == (vector<pair<int, int>>{{0, 3}, {1, 2}}));
+
+    const int CHECKS = 10000000;
+    int truced = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < CHECKS; i++)
+        truced += game.isTruced(players[i & 3], (i & 4) ? neutral : players[(i >> 3) & 3]);
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    logMessage(INFO, to_string(CHECKS) + " isTruced checks (" + to_string(truced) + " truced): " + to_string(elapsed / CHECKS) + " ns each");
+
+    game.clearTrucesForNewTurn();
+    check("New turn", !game.isTruced(players[0], neutral) && game.snapshot().truces.empty());
+
+    vector<string> crowd(GameEngine::MAX_PLAYERS + 1, "Aggressive");
+    GameEngine full;
+    check("Player limit", !full.setupGame("Maps/alberta.map", crowd) && full.getPlayers().empty());
+}
+
 /*
 int main()
 {
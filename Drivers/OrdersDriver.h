@@ -3,5 +3,9 @@
 
 void testOrdersLists();
 void testOrderExecution();
+void testCombatKernel();
+void testCompactOrders();
+void testOrderEffects();
+void testTruces();
 
 #endif // ORDERS_DRIVER_H
\ No newline at end of file
@@ -1,11 +1,16 @@
+#include "PlayerStrategyDriver.h"
 #include "../PlayerStrategies/PlayerStrategies.h"
 #include "../Models/Player.h"
 #include "../Models/Map.h"
 #include "../Models/Cards.h"
+#include "../Models/GameEngine.h"
 #include "../utils/logger.h"
 #include "../utils/LoggingObserver.h"
+#include "../utils/FreeListPool.h"
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 using namespace std;
 
@@ -220,6 +225,196 @@ void testPlayerStrategies()
 
     logMessage(INFO, "PLAYER STRATEGIES TEST COMPLETE");
 }
+
+// MCTS plays its first turn the same way whatever the thread count (the seeds are per
+// rollout), and a search stops close to its time limit even with a huge budget
+void testMCTSStrategy()
+{
+    cout << "\n=== Testing MCTS Strategy ===\n\n";
+
+    auto firstTurn = [](const string &mcts, double &seconds)
+    {
+        GameEngine game;
+        game.buildGraph();
+        game.setSeed(21);
+        GameRngScope rngScope(game.getRng());
+        GameSnapshot result;
+        if (!game.setupGame("Maps/alberta.map", {mcts, "Aggressive", "Benevolent"}))
+            return result;
+
+        auto start = chrono::steady_clock::now();
+        game.reinforcementPhase();
+        game.issueOrdersPhase();
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        for (Player *player : game.getPlayers())
+        {
+            if (player->getPlayerStrategyName() == "MCTS")
+                logMessage(INFO, mcts + ": " + to_string(player->getOrdersList()->size()) + " orders issued");
+        }
+        return game.snapshot();
+    };
+
+    logMessage(INFO, "--- TEST 1: First turn with 1 and with 4 rollout threads ---");
+    double seconds = 0.0;
+    GameSnapshot single = firstTurn("MCTS:64:0:1", seconds);
+    GameSnapshot threaded = firstTurn("MCTS:64:0:4", seconds);
+    if (!single.owner.empty() && single == threaded)
+        logMessage(INFO, "Both thread counts issued the same orders correctly");
+    else
+        logMessage(ERROR, "The thread count changed the orders issued");
+
+    logMessage(INFO, "--- TEST 2: Huge rollout budget with a 50 ms per-decision limit ---");
+    firstTurn("MCTS:1000000:50:2", seconds);
+    logMessage(INFO, "The turn took " + to_string(seconds * 1000) + " ms");
+}
+
+// The queries an AI turn makes over and over (owned territories, neighbors, cards,
+// continent members) return views: two calls must share the same storage, where copies
+// would each own a fresh buffer.
+void testViewAccessorAllocations()
+{
+    cout << "\n=== Testing View Accessors ===\n\n";
+
+    // A view holds a pointer and a length, never a buffer of its own
+    static_assert(is_trivially_copyable<Span<Territory *>>::value, "Span must not own storage");
+    static_assert(is_trivially_copyable<TerritoryRange>::value, "TerritoryRange must not own storage");
+
+    MapLoader mapLoader;
+    Map *gameMap = mapLoader.loadMap(MAP_FILE);
+    if (gameMap == nullptr)
+    {
+        logMessage(ERROR, "Map loading failed.");
+        return;
+    }
+
+    Deck gameDeck;
+    vector<Player *> players = {new Player("PostalDude77"), new Player("Jalla"), new Player("xRizz"), new Player("niCe")};
+    players[0]->setStrategy(new AggressivePlayerStrategy());
+    players[1]->setStrategy(new BenevolentPlayerStrategy());
+    players[2]->setStrategy(new NeutralPlayerStrategy());
+    players[3]->setStrategy(new CheaterPlayerStrategy());
+    gameMap->distributeTerritories(players);
+    for (Player *player : players)
+    {
+        gameDeck.draw(*player, *player->getHandOfCards());
+        gameDeck.draw(*player, *player->getHandOfCards());
+    }
+    gameMap->bindContinentCounters();
+
+    // One steady-state turn worth of queries; counts the views that did not alias
+    // the storage of an earlier call
+    auto turnQueries = [&]()
+    {
+        size_t copies = 0;
+        for (Player *player : players)
+        {
+            Span<Territory *> territories = player->getTerritories();
+            copies += territories.data() != player->getTerritories().data();
+            for (Territory *territory : territories)
+            {
+                TerritoryRange neighbors = gameMap->getNeighborsOf(territory);
+                copies += neighbors.idsBegin() != gameMap->getNeighborsOf(territory).idsBegin();
+            }
+
+            Span<Card *> cards = player->getHandOfCards()->getCards();
+            copies += cards.data() != player->getHandOfCards()->getCards().data();
+
+            for (Continent &continent : gameMap->getContinents())
+            {
+                TerritoryRange members = continent.getTerritories(gameMap);
+                copies += members.idsBegin() != continent.getTerritories(gameMap).idsBegin();
+            }
+        }
+        return copies;
+    };
+
+    logMessage(INFO, "--- TEST 1: Accessors return views into the same storage ---");
+    const int TURNS = 100;
+    size_t copies = 0;
+    for (int turn = 0; turn < TURNS; turn++)
+        copies += turnQueries();
+    if (copies == 0)
+        logMessage(INFO, "Territory, neighbor, card and continent queries shared their storage over " + to_string(TURNS) + " turns");
+    else
+        logMessage(ERROR, to_string(copies) + " queries returned a copy instead of a view");
+
+    logMessage(INFO, "--- TEST 2: A copy gets storage of its own ---");
+    bool detached = true;
+    for (Player *player : players)
+    {
+        vector<Territory *> copy = player->getTerritories().toVector();
+        detached &= copy.size() == player->getTerritories().size() &&
+                    (copy.empty() || copy.data() != player->getTerritories().data());
+    }
+    if (detached)
+        logMessage(INFO, "toVector() copies were detached from the views correctly");
+    else
+        logMessage(ERROR, "toVector() returned the view's storage");
+
+    for (Player *player : players)
+        delete player;
+    delete gameMap;
+}
+
+// Orders recycle their memory through the per-thread pool: once a turn's worth has been
+// freed, issuing, cloning and deleting the next turn's orders must not allocate
+void testOrderPoolAllocations()
+{
+    cout << "\n=== Testing Order Pool ===\n\n";
+
+    Player player("Pool_Player");
+    Player other("Other_Player");
+    Territory source("Source", 1, 0);
+    Territory target("Target", 2, 0);
+    OrderParams params{&player, &source, &target, &other, 3};
+    const OrderKind kinds[] = {OrderKind::Deploy, OrderKind::Advance, OrderKind::Bomb,
+                               OrderKind::Blockade, OrderKind::Airlift, OrderKind::Negotiate};
+
+    // One turn: every kind issued a few times, each cloned (as OrdersList copies do), all deleted
+    vector<Order *> orders;
+    orders.reserve(64);
+    bool sameParams = true;
+    auto turn = [&]()
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            for (OrderKind kind : kinds)
+            {
+                Order *order = Order::create(kind, params, nullptr, nullptr);
+                Order *copy = order->clone();
+                sameParams &= copy->kind() == kind && copy->params().target == order->params().target;
+                orders.push_back(order);
+                orders.push_back(copy);
+            }
+        }
+        for (Order *order : orders)
+            delete order;
+        orders.clear();
+    };
+
+    turn(); // warm-up: fills the pool
+    size_t pooled = FreeListPool::freeBlocks();
+
+    const int TURNS = 100;
+    size_t heapBefore = FreeListPool::heapBlocks();
+    for (int i = 0; i < TURNS; i++)
+        turn();
+    size_t orderAllocations = FreeListPool::heapBlocks() - heapBefore;
+
+    logMessage(INFO, "--- TEST 1: Warm-up turn fills the pool ---");
+    if (pooled > 0 && sameParams)
+        logMessage(INFO, to_string(pooled) + " blocks pooled after one turn, clones kept their parameters");
+    else
+        logMessage(ERROR, "Warm-up turn left " + to_string(pooled) + " blocks pooled");
+
+    logMessage(INFO, "--- TEST 2: " + to_string(TURNS) + " more turns of " + to_string(2 * 4 * 6) + " orders ---");
+    if (orderAllocations == 0)
+        logMessage(INFO, "Every order reused a pooled block correctly");
+    else
+        logMessage(ERROR, "The pool took " + to_string(orderAllocations) + " new blocks from the heap");
+}
+
 /*
 int main()
 {
@@ -2,5 +2,8 @@
 #define PLAYER_STRATEGY_DRIVE_H
 
 void testPlayerStrategies();
+void testViewAccessorAllocations();
+void testOrderPoolAllocations();
+void testMCTSStrategy();
 
 #endif
\ No newline at end of file
@@ -9,25 +9,31 @@ using namespace std;
 
 void testTournament(vector<string> mapFiles,
                     vector<string> playerStrategies,
-                    int numGames, int maxTurns)
+                    int numGames, int maxTurns, int numThreads, long long seed, ConsoleMode consoleMode,
+                    string recordFile, StalemateRule stalemateRule, FastForwardRule fastForwardRule)
 {
     LogObserver::getInstance();
 
     logMessage(EVENT, "=== Testing Tournament Mode with Player Strategies ===");
+    setConsoleMode(consoleMode);
 
     GameEngine engine;
     engine.buildGraph();
+    engine.setStalemateRule(stalemateRule);
+    engine.setFastForwardRule(fastForwardRule);
 
     try
     {
-        engine.runTournament(mapFiles, playerStrategies, numGames, maxTurns);
+        engine.runTournament(mapFiles, playerStrategies, numGames, maxTurns, numThreads, seed, recordFile);
     }
     catch (const std::exception &e)
     {
         logMessage(ERROR, string("Tournament error: ") + e.what());
+        flushConsole();
         exit(1);
     }
 
+    setConsoleMode(CONSOLE_VERBOSE); // writes out anything buffered
     logMessage(EVENT, "=== Tournament Test Complete ===");
 
     // Clean up global logger at program end
@@ -38,7 +44,13 @@ bool argumentValidator(int argc, char *argv[],
                        vector<string> &mapFiles,
                        vector<string> &playerStrategies,
                        int &numGames,
-                       int &maxTurns)
+                       int &maxTurns,
+                       int &numThreads,
+                       long long &seed,
+                       ConsoleMode &consoleMode,
+                       string &recordFile,
+                       StalemateRule &stalemateRule,
+                       FastForwardRule &fastForwardRule)
 {
 
     // Initialize the logger
@@ -47,7 +59,7 @@ bool argumentValidator(int argc, char *argv[],
     if (argc < 2)
     {
         cout << "No arguments provided." << endl;
-        cout << "Usage: tournament -M <mapfiles> -P <strategies> -G <games> -D <turns>" << endl;
+        cout << "Usage: tournament -M <mapfiles> -P <strategies> -G <games> -D <turns> [-J <threads>] [-S <seed>] [-R <recordfile>] [--stalemate <turns>[:<repeats>]] [--fast-forward <confidence>] [--quiet | --progress] [--log-level <debug|ai|event|warning|error>]" << endl;
         cout << "Note: Use quotes for paths with spaces: -M \"path with spaces.map\"" << endl;
         return false;
     }
@@ -140,6 +152,108 @@ bool argumentValidator(int argc, char *argv[],
                 return false;
             }
         }
+        else if (arg == "-J" && i + 1 < argc)
+        {
+            try
+            {
+                numThreads = stoi(argv[++i]);
+            }
+            catch (const exception &e)
+            {
+                logMessage(ERROR, "Invalid number for -J");
+                return false;
+            }
+        }
+        else if (arg == "-S" && i + 1 < argc)
+        {
+            try
+            {
+                seed = stoll(argv[++i]);
+            }
+            catch (const exception &e)
+            {
+                logMessage(ERROR, "Invalid number for -S");
+                return false;
+            }
+            if (seed < 0)
+            {
+                logMessage(ERROR, "Error: Seed must not be negative (-S)");
+                return false;
+            }
+        }
+        else if (arg == "-R" && i + 1 < argc)
+        {
+            recordFile = argv[++i];
+        }
+        else if (arg == "--stalemate" && i + 1 < argc)
+        {
+            // <turns> without a territory changing hands, then optionally :<repeats> of one position
+            string rule = argv[++i];
+            size_t colon = rule.find(':');
+            try
+            {
+                stalemateRule.window = stoi(rule.substr(0, colon));
+                if (colon != string::npos)
+                    stalemateRule.repeats = stoi(rule.substr(colon + 1));
+            }
+            catch (const exception &e)
+            {
+                logMessage(ERROR, "Invalid rule for --stalemate (expected <turns>[:<repeats>])");
+                return false;
+            }
+            if (stalemateRule.window < 0 || stalemateRule.repeats < 0)
+            {
+                logMessage(ERROR, "Error: Stalemate turns and repeats must not be negative (--stalemate)");
+                return false;
+            }
+        }
+        else if (arg == "--fast-forward" && i + 1 < argc)
+        {
+            // lowest confidence at which a predicted result ends a game
+            try
+            {
+                fastForwardRule.minConfidence = stod(argv[++i]);
+            }
+            catch (const exception &e)
+            {
+                logMessage(ERROR, "Invalid confidence for --fast-forward (expected a number in (0, 1])");
+                return false;
+            }
+            if (fastForwardRule.minConfidence <= 0 || fastForwardRule.minConfidence > 1)
+            {
+                logMessage(ERROR, "Error: Fast-forward confidence must be in (0, 1] (--fast-forward)");
+                return false;
+            }
+            fastForwardRule.enabled = true;
+        }
+        else if (arg == "--log-level" && i + 1 < argc)
+        {
+            // lowest level logged; one level per tier (see logTier)
+            string level = argv[++i];
+            if (level == "debug")
+                setLogLevel(DEBUG);
+            else if (level == "ai")
+                setLogLevel(AI);
+            else if (level == "event")
+                setLogLevel(EVENT);
+            else if (level == "warning")
+                setLogLevel(WARNING);
+            else if (level == "error")
+                setLogLevel(ERROR);
+            else
+            {
+                logMessage(ERROR, "Invalid level for --log-level (expected debug, ai, event, warning or error)");
+                return false;
+            }
+        }
+        else if (arg == "--quiet")
+        {
+            consoleMode = CONSOLE_QUIET;
+        }
+        else if (arg == "--progress")
+        {
+            consoleMode = CONSOLE_PROGRESS;
+        }
         else
         {
             logMessage(ERROR, "Unknown argument: " + arg);
@@ -158,6 +272,11 @@ bool argumentValidator(int argc, char *argv[],
         logMessage(ERROR, "Error: At least one player strategy required (-P)");
         return false;
     }
+    if (playerStrategies.size() > static_cast<size_t>(GameEngine::MAX_PLAYERS))
+    {
+        logMessage(ERROR, "Error: At most " + to_string(static_cast<int>(GameEngine::MAX_PLAYERS)) + " player strategies allowed (-P)");
+        return false;
+    }
     if (numGames <= 0)
     {
 
@@ -169,15 +288,32 @@ bool argumentValidator(int argc, char *argv[],
         logMessage(ERROR, "Error: Max turns must be positive (-D)");
         return false;
     }
-    logMessage(INFO, "Maps:");
-    for (const auto &map : mapFiles)
-        cout << " " + map << endl;
-    logMessage(INFO, "Players:");
-    for (const auto &player : playerStrategies)
-        cout << " " + player;
-    cout << "\n";
-    logMessage(INFO, "Games: " + to_string(numGames));
-    logMessage(INFO, "Max Turn: " + to_string(maxTurns));
+    if (numThreads <= 0)
+    {
+        logMessage(ERROR, "Error: Number of threads must be positive (-J)");
+        return false;
+    }
+    if (consoleMode == CONSOLE_VERBOSE)
+    {
+        logMessage(INFO, "Maps:");
+        for (const auto &map : mapFiles)
+            cout << " " + map << endl;
+        logMessage(INFO, "Players:");
+        for (const auto &player : playerStrategies)
+            cout << " " + player;
+        cout << "\n";
+        logMessage(INFO, "Games: " + to_string(numGames));
+        logMessage(INFO, "Max Turn: " + to_string(maxTurns));
+        logMessage(INFO, "Threads: " + to_string(numThreads));
+        if (seed >= 0)
+            logMessage(INFO, "Seed: " + to_string(seed));
+        if (!recordFile.empty())
+            logMessage(INFO, "Recording to: " + recordFile);
+        if (stalemateRule.enabled())
+            logMessage(INFO, "Stalemate: " + to_string(stalemateRule.window) + ":" + to_string(stalemateRule.repeats));
+        if (fastForwardRule.enabled)
+            logMessage(INFO, "Fast-forward: " + to_string(fastForwardRule.minConfidence));
+    }
 
     // Log tournament details to file
     logger->logToFile(EVENT, "Tournament mode:");
@@ -205,6 +341,15 @@ bool argumentValidator(int argc, char *argv[],
     // Log games and max turns
     logger->logToFile(EVENT, "G: " + to_string(numGames));
     logger->logToFile(EVENT, "D: " + to_string(maxTurns));
+    logger->logToFile(EVENT, "J: " + to_string(numThreads));
+    if (seed >= 0)
+        logger->logToFile(EVENT, "S: " + to_string(seed));
+    if (!recordFile.empty())
+        logger->logToFile(EVENT, "R: " + recordFile);
+    if (stalemateRule.enabled())
+        logger->logToFile(EVENT, "Stalemate: " + to_string(stalemateRule.window) + ":" + to_string(stalemateRule.repeats));
+    if (fastForwardRule.enabled)
+        logger->logToFile(EVENT, "Fast-forward: " + to_string(fastForwardRule.minConfidence));
 
     return true; // All validations passed
 }
@@ -216,11 +361,17 @@ int main(int argc, char *argv[])
     vector<string> playerStrategies;
     int numGames = 0;
     int maxTurns = 0;
+    int numThreads = 1;
+    long long seed = -1;
+    ConsoleMode consoleMode = CONSOLE_VERBOSE;
+    string recordFile;
+    StalemateRule stalemateRule;
+    FastForwardRule fastForwardRule;
 
-    if (!argumentValidator(argc, argv, mapFiles, playerStrategies, numGames, maxTurns))
+    if (!argumentValidator(argc, argv, mapFiles, playerStrategies, numGames, maxTurns, numThreads, seed, consoleMode, recordFile, stalemateRule, fastForwardRule))
     {
         exit(1);
     }
-    testTournament(mapFiles, playerStrategies, numGames, maxTurns);
+    testTournament(mapFiles, playerStrategies, numGames, maxTurns, numThreads, seed, consoleMode, recordFile, stalemateRule, fastForwardRule);
     return 0;
 }*/
\ No newline at end of file
@@ -1,13 +1,30 @@
 #ifndef TOURNAMENT_DRIVER_H
 #define TOURNAMENT_DRIVER_H
+#include <string>
+#include <vector>
+#include "../utils/logger.h"
+#include "../Models/Stalemate.h"
+#include "../Models/FastForward.h"
 using namespace std;
 void testTournament(vector<string> mapFiles,
                     vector<string> playerStrategies,
                     int numGames,
-                    int maxTurns);
+                    int maxTurns,
+                    int numThreads = 1,
+                    long long seed = -1,
+                    ConsoleMode consoleMode = CONSOLE_VERBOSE,
+                    string recordFile = "",
+                    StalemateRule stalemateRule = StalemateRule(),
+                    FastForwardRule fastForwardRule = FastForwardRule());
 bool argumentValidator(int argc, char *argv[],
                        vector<string> &mapFiles,
                        vector<string> &playerStrategies,
                        int &numGames,
-                       int &maxTurns);
+                       int &maxTurns,
+                       int &numThreads,
+                       long long &seed,
+                       ConsoleMode &consoleMode,
+                       string &recordFile,
+                       StalemateRule &stalemateRule,
+                       FastForwardRule &fastForwardRule);
 #endif
\ No newline at end of file
@@ -226,10 +226,150 @@ void Assignment_02_Menu()
     }
 }
 
+void Performance_Tests_Menu()
+{
+    string cmd;
+    while (true)
+    {
+        // Display menu as written
+        cout << R"(
+╔══════════════════════════════════════════════════════════════════════════════════╗
+║                         Engine Performance Tests                                 ║
+╠══════════════════════════════════════════════════════════════════════════════════╣
+║                                                                                  ║
+║  1) Run testCombatKernel()            - Binomial kernel vs per-army reference    ║
+║  2) Run testViewAccessorAllocations() - Views, not copies, for AI queries        ║
+║  3) Run testGameSnapshot()            - Snapshot, restore and fork a game        ║
+║  4) Run testMCTSStrategy()            - Same turn on 1 or 4 threads; time limit  ║
+║  5) Run testTypedGameLoop()           - Typed vs virtual dispatch game loop      ║
+║  6) Run testGameReplay()              - Record a game, replay and seek it        ║
+║  7) Run testReplayKeyframes()         - Seek a long replay via keyframes         ║
+║  8) Run testStalemateDetection()      - Early draws of stalled games             ║
+║  9) Run testFastForward()             - Forecasts end settled games early        ║
+║  10) Run testObserverRegistry()       - Observers get only the levels they take  ║
+║  11) Run testOrderPoolAllocations()   - Orders reuse pooled memory               ║
+║  12) Run testCompactOrders()          - Pending orders survive a fork            ║
+║  13) Run testOrderEffects()           - Order outcomes and their text            ║
+║  14) Run testTruces()                 - Truces by player slot                    ║
+║                                                                                  ║
+║  Type "back" to return                                                           ║
+╚══════════════════════════════════════════════════════════════════════════════════╝
+    )";
+        cout << "Enter the number of a test else type 'back' to return." << endl;
+        if (!getline(cin, cmd) || cmd == "back")
+            break;
+
+        if (cmd == "1")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                  TEST COMBAT KERNEL                   " << endl;
+            cout << "=======================================================" << endl;
+            testCombatKernel();
+        }
+        else if (cmd == "2")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                  TEST VIEW ACCESSORS                  " << endl;
+            cout << "=======================================================" << endl;
+            testViewAccessorAllocations();
+        }
+        else if (cmd == "3")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                  TEST GAME SNAPSHOTS                  " << endl;
+            cout << "=======================================================" << endl;
+            testGameSnapshot();
+        }
+        else if (cmd == "4")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                  TEST MCTS STRATEGY                   " << endl;
+            cout << "=======================================================" << endl;
+            testMCTSStrategy();
+        }
+        else if (cmd == "5")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                 TEST TYPED GAME LOOP                  " << endl;
+            cout << "=======================================================" << endl;
+            testTypedGameLoop();
+        }
+        else if (cmd == "6")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                   TEST GAME REPLAY                    " << endl;
+            cout << "=======================================================" << endl;
+            testGameReplay();
+        }
+        else if (cmd == "7")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                 TEST REPLAY KEYFRAMES                 " << endl;
+            cout << "=======================================================" << endl;
+            testReplayKeyframes();
+        }
+        else if (cmd == "8")
+        {
+            cout << "=======================================================" << endl;
+            cout << "               TEST STALEMATE DETECTION                " << endl;
+            cout << "=======================================================" << endl;
+            testStalemateDetection();
+        }
+        else if (cmd == "9")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                   TEST FAST-FORWARD                   " << endl;
+            cout << "=======================================================" << endl;
+            testFastForward();
+        }
+        else if (cmd == "10")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                TEST OBSERVER REGISTRY                 " << endl;
+            cout << "=======================================================" << endl;
+            testObserverRegistry();
+        }
+        else if (cmd == "11")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                    TEST ORDER POOL                    " << endl;
+            cout << "=======================================================" << endl;
+            testOrderPoolAllocations();
+        }
+        else if (cmd == "12")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                  TEST COMPACT ORDERS                  " << endl;
+            cout << "=======================================================" << endl;
+            testCompactOrders();
+        }
+        else if (cmd == "13")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                  TEST ORDER EFFECTS                   " << endl;
+            cout << "=======================================================" << endl;
+            testOrderEffects();
+        }
+        else if (cmd == "14")
+        {
+            cout << "=======================================================" << endl;
+            cout << "                      TEST TRUCES                      " << endl;
+            cout << "=======================================================" << endl;
+            testTruces();
+        }
+        else
+        {
+            cout << "Unknown Command. Please try again." << endl;
+        }
+    }
+}
+
 void Assignment_03_Menu(vector<string> mapFiles,
                         vector<string>
                             playerStrategies,
-                        int numGames, int maxTurns)
+                        int numGames, int maxTurns, int numThreads, long long seed,
+                        ConsoleMode consoleMode, string recordFile, StalemateRule stalemateRule,
+                        FastForwardRule fastForwardRule)
 {
     string cmd;
     // Display menu as written
@@ -243,10 +383,11 @@ void Assignment_03_Menu(vector<string> mapFiles,
 ║                                                                                  ║
 ║  1) Run testPlayerStrategies()   - Part 1: Run Player Strategies                 ║
 ║  2) Run testTournament()         - Part 2: Test Tournament Phase                 ║             
+║  3) Run Performance_Tests_Menu() - Engine performance tests                      ║
 ║  Type "quit" to exit                                                             ║
 ╚══════════════════════════════════════════════════════════════════════════════════╝
     )";
-        cout << "Enter one of the following choices [1/2] else type 'quit' to exit."
+        cout << "Enter one of the following choices [1/2/3] else type 'quit' to exit."
              << endl;
         if (!getline(cin, cmd))
             break;
@@ -274,11 +415,15 @@ void Assignment_03_Menu(vector<string> mapFiles,
             cout << "=======================================================" << endl;
             cout << "                     TEST TOURNAMENT                   " << endl;
             cout << "=======================================================" << endl;
-            testTournament(mapFiles, playerStrategies, numGames, maxTurns);
+            testTournament(mapFiles, playerStrategies, numGames, maxTurns, numThreads, seed, consoleMode, recordFile, stalemateRule, fastForwardRule);
             cout << "=======================================================" << endl;
             cout << "                 END OF TEST TOURNAMENT                " << endl;
             cout << "=======================================================" << endl;
         }
+        else if (cmd == "3")
+        {
+            Performance_Tests_Menu();
+        }
         else
         {
             cout << "Unknown Command. Please try again." << endl;
@@ -295,15 +440,21 @@ int main(int argc, char *argv[])
     vector<string> playerStrategies;
     int numGames = 0;
     int maxTurns = 0;
+    int numThreads = 1;
+    long long seed = -1;
+    ConsoleMode consoleMode = CONSOLE_VERBOSE;
+    string recordFile;
+    StalemateRule stalemateRule;
+    FastForwardRule fastForwardRule;
 
-    if (!argumentValidator(argc, argv, mapFiles, playerStrategies, numGames, maxTurns))
+    if (!argumentValidator(argc, argv, mapFiles, playerStrategies, numGames, maxTurns, numThreads, seed, consoleMode, recordFile, stalemateRule, fastForwardRule))
     {
         exit(1);
     }
 
     Assignment_03_Menu(mapFiles,
 
-                       playerStrategies, numGames, maxTurns);
+                       playerStrategies, numGames, maxTurns, numThreads, seed, consoleMode, recordFile, stalemateRule, fastForwardRule);
     /*
     string cmd;
 
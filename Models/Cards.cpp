@@ -5,6 +5,7 @@
 #include <random>
 #include <sstream>
 #include <algorithm>
+#include "../utils/GameRng.h"
 #include "../utils/logger.h"
 using namespace std;
 
@@ -38,10 +39,6 @@ const char *CardTypeToString(CardType type)
     }
 }
 
-// One RNG for the TU
-static random_device rd;
-static mt19937 rng(rd());
-
 // ----------------- Card -----------------
 Card::Card(CardType t) : type(t)
 {
@@ -76,8 +73,7 @@ ostream &operator<<(ostream &os, const Card &card)
 
 void Card::play(Player &player, OrdersList &ordersList, Deck &deck)
 {
-    logMessage(COMBAT, string("Playing card: ") + CardTypeToString(type));
-    Notify(this, COMBAT, string("Playing card: ") + CardTypeToString(type));
+    LOG_NOTIFY(COMBAT, "Playing card: ", CardTypeToString(type));
 
     // Create the appropriate Order and add it to OrdersList.
     // Mapping:
@@ -90,52 +86,43 @@ void Card::play(Player &player, OrdersList &ordersList, Deck &deck)
     switch (type)
     {
     case CardType::Bomb:
-        logMessage(INVENTORY, " -> Creating Bomb order.");
-        Notify(this, INVENTORY, " -> Creating Bomb order.");
+        LOG_NOTIFY(INVENTORY, " -> Creating Bomb order.");
         newOrder = new Bomb();
         break;
     case CardType::Reinforcement:
-        logMessage(INVENTORY, " -> Creating Deploy order (from Reinforcement).");
-        Notify(this, INVENTORY, " -> Creating Deploy order (from Reinforcement).");
+        LOG_NOTIFY(INVENTORY, " -> Creating Deploy order (from Reinforcement).");
         newOrder = new Deploy();
         break;
     case CardType::Blockade:
-        logMessage(DEBUG, " -> Creating Blockade order.");
-        Notify(this, INVENTORY, " -> Creating Blockade order.");
+        LOG_NOTIFY(INVENTORY, " -> Creating Blockade order.");
         newOrder = new Blockade();
         break;
     case CardType::Airlift:
-        logMessage(INVENTORY, " -> Creating Airlift order.");
-        Notify(this, INVENTORY, " -> Creating Airlift order.");
+        LOG_NOTIFY(INVENTORY, " -> Creating Airlift order.");
         newOrder = new Airlift();
         break;
     case CardType::Diplomacy:
-        logMessage(INVENTORY, " -> Creating Negotiate order.");
-        Notify(this, INVENTORY, " -> Creating Negotiate order.");
+        LOG_NOTIFY(INVENTORY, " -> Creating Negotiate order.");
         newOrder = new Negotiate();
         break;
     default:
-        logMessage(ERROR, "Unknown card type, no order created.");
-        Notify(this, ERROR, "Unknown card type, no order created.");
+        LOG_NOTIFY(ERROR, "Unknown card type, no order created.");
         break;
     }
 
     if (newOrder)
     {
         ordersList.add(newOrder);
-        logMessage(INVENTORY, "Order added to OrdersList.");
-        Notify(this, INVENTORY, "Order added to OrdersList.");
+        LOG_NOTIFY(INVENTORY, "Order added to OrdersList.");
     }
     else
     {
-        logMessage(WARNING, "No order created.");
-        Notify(this, WARNING, "No order created.");
+        LOG_NOTIFY(WARNING, "No order created.");
     }
 
     // After playing, return this card to the deck.
     deck.returnCard(this);
-    logMessage(INVENTORY, " -> Card returned to deck.");
-    Notify(this, INVENTORY, " -> Card returned to deck.");
+    LOG_NOTIFY(INVENTORY, " -> Card returned to deck.");
 }
 
 // ----------------- Hand -----------------
@@ -155,7 +142,7 @@ Hand::Hand(const Hand &other)
     DebugPrint("Hand copy-constructed with " + to_string(cards.size()) + " cards");
 }
 
-vector<Card *> Hand::getCards() const
+Span<Card *> Hand::getCards() const
 {
     return cards;
 }
@@ -186,9 +173,19 @@ Hand::~Hand()
 void Hand::addCard(Card *c)
 {
     cards.push_back(c);
-    ostringstream oss;
-    oss << *c;
-    DebugPrint("Added to hand: " + oss.str());
+    if (DEBUG_CARDS)
+    {
+        ostringstream oss;
+        oss << *c;
+        DebugPrint("Added to hand: " + oss.str());
+    }
+}
+
+vector<Card *> Hand::releaseCards()
+{
+    vector<Card *> released;
+    released.swap(cards);
+    return released;
 }
 
 Card *Hand::removeAt(size_t index)
@@ -237,7 +234,7 @@ Deck::Deck()
         cards.push_back(new Card(CardType::Airlift));
         cards.push_back(new Card(CardType::Diplomacy));
     }
-    shuffle(cards.begin(), cards.end(), rng);
+    shuffle(cards.begin(), cards.end(), currentGameRng());
     DebugPrint("Deck constructed with " + to_string(cards.size()) + " cards");
 }
 
@@ -278,7 +275,7 @@ Card *Deck::draw(Player & /*player*/, Hand &hand)
         return nullptr;
     }
     uniform_int_distribution<size_t> dist(0, cards.size() - 1);
-    size_t idx = dist(rng);
+    size_t idx = dist(currentGameRng());
 
     Card *c = cards[idx];
     cards.erase(cards.begin() + idx);
@@ -295,9 +292,19 @@ Card *Deck::draw(Player & /*player*/, Hand &hand)
 void Deck::returnCard(Card *c)
 {
     cards.push_back(c);
-    ostringstream oss;
-    oss << *c;
-    DebugPrint("Deck::returnCard received " + oss.str());
+    if (DEBUG_CARDS)
+    {
+        ostringstream oss;
+        oss << *c;
+        DebugPrint("Deck::returnCard received " + oss.str());
+    }
+}
+
+vector<Card *> Deck::releaseCards()
+{
+    vector<Card *> released;
+    released.swap(cards);
+    return released;
 }
 
 ostream &operator<<(ostream &os, const Deck &d)
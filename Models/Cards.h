@@ -4,6 +4,7 @@
 #include <vector>
 #include <iosfwd>
 #include "../utils/LoggingObserver.h"
+#include "../utils/Span.h"
 class Player;
 class OrdersList;
 class Deck;
@@ -24,6 +25,9 @@ const char *CardTypeToString(CardType type);
 
 class Card : public Subject, public ILoggable
 {
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_CARD; }
+
 private:
     CardType type;
 
@@ -33,6 +37,8 @@ public:
     Card &operator=(const Card &other);
     ~Card();
 
+    CardType getType() const { return type; }
+
     // Play creates an Order (adds to OrdersList) then returns this card to the Deck
     void play(Player &player, OrdersList &ordersList, Deck &deck);
 
@@ -42,6 +48,9 @@ public:
 // ----------------- Hand -----------------
 class Hand : public Subject, public ILoggable
 {
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_CARD; }
+
 private:
     std::vector<Card *> cards;
 
@@ -52,10 +61,11 @@ public:
     ~Hand();
 
     size_t size() const;
-    std::vector<Card *> getCards() const;
+    Span<Card *> getCards() const; // view, no copy
 
     void addCard(Card *c);
     Card *removeAt(std::size_t idx);
+    std::vector<Card *> releaseCards(); // empties the hand; the caller owns the cards
 
     // Remove card at index, call Card::play (which returns the card to the deck)
     void playCard(std::size_t index, Player &player, OrdersList &ordersList, Deck &deck);
@@ -66,6 +76,9 @@ public:
 // ----------------- Deck -----------------
 class Deck : public Subject, public ILoggable
 {
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_CARD; }
+
 private:
     std::vector<Card *> cards;
 
@@ -81,6 +94,10 @@ public:
     // When a card is played, it is returned to the deck.
     void returnCard(Card *c);
 
+    size_t size() const { return cards.size(); }
+    Span<Card *> getCards() const { return cards; } // draw order matters: view, no copy
+    std::vector<Card *> releaseCards();             // empties the deck; the caller owns the cards
+
     friend std::ostream &operator<<(std::ostream &os, const Deck &d);
 };
 
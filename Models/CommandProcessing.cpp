@@ -78,8 +78,7 @@ FileLineReader::FileLineReader(const string &fileName)
 {
     if (!fileStream->is_open())
     {
-        logMessage(ERROR, "Error: Could not open file " + fileName);
-        Notify(this, ERROR, "Error: Could not open file " + fileName);
+        LOG_NOTIFY(ERROR, "Error: Could not open file ", fileName);
     }
 }
 
@@ -129,8 +128,7 @@ string FileLineReader::readLineFromFile()
         return line;
     }
 
-    logMessage(DEBUG, "End of file or error reading file.");
-    Notify(this, DEBUG, "End of file or error reading file.");
+    LOG_NOTIFY(DEBUG, "End of file or error reading file.");
     return ""; // Return empty string if EOF or error
 }
 
@@ -230,8 +228,7 @@ void CommandProcessor::saveCommand(Command *cmd)
     if (cmd != nullptr)
     {
         commands.push_back(cmd); // add to vector
-        logMessage(INFO, "Command saved: " + cmd->getCommand());
-        Notify(this, INFO, "Command saved: " + cmd->getCommand());
+        LOG_NOTIFY(INFO, "Command saved: ", cmd->getCommand());
     }
 }
 
@@ -270,8 +267,7 @@ bool CommandProcessor::validate(Command *cmd, GameEngine *engine)
     string commandName;
     iss >> commandName; // Extract first word
 
-    logMessage(PROGRESSION, "Current State: " + currentState);
-    Notify(this, PROGRESSION, "Current State: " + currentState);
+    LOG_NOTIFY(PROGRESSION, "Current State: ", currentState);
     if (cmd->getCommand().rfind("tournament", 0) == 0)
     {
         std::string commandText = cmd->getCommand();
@@ -283,7 +279,8 @@ bool CommandProcessor::validate(Command *cmd, GameEngine *engine)
             tokens.push_back(tok);
 
         std::vector<std::string> maps, strategies;
-        int games = 0, turns = 0;
+        int games = 0, turns = 0, threads = 1;
+        long long seed = -1;
 
         for (size_t i = 1; i < tokens.size(); i++)
         {
@@ -309,6 +306,14 @@ bool CommandProcessor::validate(Command *cmd, GameEngine *engine)
             {
                 turns = std::stoi(tokens[++i]);
             }
+            else if (tokens[i] == "-J")
+            {
+                threads = std::stoi(tokens[++i]);
+            }
+            else if (tokens[i] == "-S")
+            {
+                seed = std::stoll(tokens[++i]);
+            }
         }
 
         if (maps.size() < 1 || maps.size() > 5)
@@ -319,12 +324,18 @@ bool CommandProcessor::validate(Command *cmd, GameEngine *engine)
             return false;
         if (turns < 10 || turns > 50)
             return false;
+        if (threads < 1)
+            return false;
+        if (seed < -1)
+            return false;
 
         // Save inside the command
         cmd->tournamentMaps = maps;
         cmd->tournamentStrategies = strategies;
         cmd->tournamentGames = games;
         cmd->tournamentMaxTurns = turns;
+        cmd->tournamentThreads = threads;
+        cmd->tournamentSeed = seed;
 
         if (currentState != "start")
         {
@@ -343,23 +354,20 @@ bool CommandProcessor::validate(Command *cmd, GameEngine *engine)
         iss >> argument;
         if (argument.empty())
         {
-            logMessage(ERROR, "No map file path is found.");
-            Notify(this, ERROR, "No map file path is found.");
+            LOG_NOTIFY(ERROR, "No map file path is found.");
             return false;
         }
         try
         {
             if (!filesystem::exists(argument)) // file path does not exist
             {
-                logMessage(ERROR, "This file path does not exist");
-                Notify(this, ERROR, "This file path does not exist");
+                LOG_NOTIFY(ERROR, "This file path does not exist");
                 return false;
             }
         }
         catch (const filesystem::filesystem_error &err)
         {
-            logMessage(ERROR, "FileSystem Error: " + string(err.what()));
-            Notify(this, ERROR, "FileSystem Error: " + string(err.what()));
+            LOG_NOTIFY(ERROR, "FileSystem Error: ", err.what());
             return false;
         }
 
@@ -517,7 +525,7 @@ string FileCommandProcessorAdapter::readCommand()
         }
         else
         {
-            logMessage(DEBUG, "End of file or empty line");
+            LOG_MESSAGE(DEBUG, "End of file or empty line");
             return "";
         }
     }
@@ -14,6 +14,7 @@ class FileLineReader;
 class CommandProcessor : public Subject, public ILoggable
 {
 public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_COMMAND; }
     // Constructor
     CommandProcessor();
 
@@ -78,6 +79,7 @@ private:
 class FileLineReader : public Subject, public ILoggable
 {
 public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_COMMAND; }
     // Constructor - opens file
     FileLineReader(const std::string &fileName);
 
@@ -106,6 +108,7 @@ private:
 class Command : public Subject, public ILoggable
 {
 public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_COMMAND; }
     // Constructor - creates command with given text
     Command(const std::string &commandText);
 
@@ -134,6 +137,8 @@ public:
     std::vector<std::string> tournamentStrategies;
     int tournamentGames = 0;
     int tournamentMaxTurns = 0;
+    int tournamentThreads = 1;
+    long long tournamentSeed = -1; // -1: draw a random seed
 
 private:
     std::string command; // The command text
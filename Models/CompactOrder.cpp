@@ -0,0 +1,44 @@
+#include "CompactOrder.h"
+#include "GameEngine.h"
+#include "Map.h"
+#include "Player.h"
+
+using namespace std;
+
+Player *OrderContext::player(int slot) const
+{
+    return engine->playerAtSlot(slot);
+}
+
+Territory *OrderContext::territory(int id) const
+{
+    Map *map = engine->getMap();
+    if (!map || id < 0 || id >= map->getTerritoriesSize())
+        return nullptr;
+    return map->getTerritoryById(id);
+}
+
+int16_t OrderContext::slotOf(const Player *player) const
+{
+    return static_cast<int16_t>(engine->slotOf(player));
+}
+
+OrderParams OrderContext::paramsOf(const CompactOrder &order) const
+{
+    OrderParams params;
+    params.issuer = player(order.issuer);
+    params.other = player(order.other);
+    params.source = territory(order.source);
+    params.target = territory(order.target);
+    params.armies = order.armies;
+    return params;
+}
+
+CompactOrder OrderContext::compact(const Order &order) const
+{
+    OrderParams params = order.params();
+    auto idOf = [](const Territory *territory)
+    { return territory ? territory->getId() : CompactOrder::NO_TERRITORY; };
+    return {order.kind(), slotOf(params.issuer), slotOf(params.other), idOf(params.source), idOf(params.target),
+            params.armies};
+}
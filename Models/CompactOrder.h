@@ -0,0 +1,58 @@
+#ifndef COMPACT_ORDER_H
+#define COMPACT_ORDER_H
+
+#include <cstdint>
+#include <type_traits>
+#include "Orders.h"
+
+class GameEngine;
+class Map;
+class Player;
+class Territory;
+
+// An order as a 20-byte value: its kind, player slots and territory ids instead of
+// pointers, with no text and no observer base. Copying a queue of them is a memcpy and
+// writing one out needs no translation (GameSnapshot stores its pending orders this way).
+// Slots and ids mean something only within one game; OrderContext resolves them.
+struct CompactOrder
+{
+    static const int NO_PLAYER = -1;
+    static const int NO_TERRITORY = -1;
+
+    OrderKind kind;
+    int16_t issuer; // player slot or NO_PLAYER
+    int16_t other;  // player slot or NO_PLAYER (Negotiate)
+    int32_t source; // territory id or NO_TERRITORY
+    int32_t target; // territory id or NO_TERRITORY
+    int32_t armies;
+
+    bool operator==(const CompactOrder &o) const
+    {
+        return kind == o.kind && issuer == o.issuer && other == o.other && source == o.source &&
+               target == o.target && armies == o.armies;
+    }
+};
+
+static_assert(sizeof(CompactOrder) == 20, "CompactOrder is meant to stay 20 bytes");
+static_assert(std::is_trivially_copyable<CompactOrder>::value, "CompactOrder must copy as raw bytes");
+
+// One game's meaning for slots and ids: the engine's current slots (GameEngine::slotOf),
+// so a context stays valid as players are eliminated. The neutral slot resolves only
+// once the neutral player exists; looking it up never creates it.
+class OrderContext
+{
+public:
+    explicit OrderContext(const GameEngine &engine) : engine(&engine) {}
+
+    Player *player(int slot) const;
+    Territory *territory(int id) const;
+    int16_t slotOf(const Player *player) const;
+
+    OrderParams paramsOf(const CompactOrder &order) const;
+    CompactOrder compact(const Order &order) const;
+
+private:
+    const GameEngine *engine;
+};
+
+#endif
@@ -0,0 +1,233 @@
+#include "FastForward.h"
+#include "GameEngine.h"
+#include "Map.h"
+#include "Player.h"
+#include "Orders.h"
+#include "../PlayerStrategies/PlayerStrategies.h"
+#include "../utils/GameRng.h"
+#include "../utils/logger.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// ----------------- Combat estimator -----------------
+
+CombatEstimator::Estimate CombatEstimator::estimate(int attackers, int defenders)
+{
+    if (attackers <= 0)
+        return {0.0, 0.0};
+    if (defenders <= 0)
+        return {1.0, static_cast<double>(attackers)};
+
+    uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(attackers)) << 32 | static_cast<uint32_t>(defenders);
+    auto cached = cache.find(key);
+    if (cached != cache.end())
+        return cached->second;
+
+    GameRng rng(key, 0xC0FFEE);
+    int wins = 0;
+    long long survivors = 0;
+    for (int i = 0; i < samples; i++)
+    {
+        BattleResult battle = resolveBattle(attackers, defenders, rng);
+        if (battle.defenders == 0 && battle.attackers > 0)
+        {
+            wins++;
+            survivors += battle.attackers;
+        }
+    }
+    Estimate result{static_cast<double>(wins) / samples, wins ? static_cast<double>(survivors) / wins : 0.0};
+    cache.emplace(key, result);
+    return result;
+}
+
+// ----------------- Forecaster -----------------
+
+enum class Stance
+{
+    Passive, // Neutral: never issues an order
+    Mover,   // Benevolent: moves armies between its own territories only
+    Cheater,
+    Aggressor, // Aggressive, MCTS
+    Unknown    // Human
+};
+
+static Stance stanceOf(Player *player)
+{
+    PlayerStrategy *strategy = player->getStrategy();
+    if (dynamic_cast<NeutralPlayerStrategy *>(strategy))
+        return Stance::Passive;
+    if (dynamic_cast<BenevolentPlayerStrategy *>(strategy))
+        return Stance::Mover;
+    if (dynamic_cast<CheaterPlayerStrategy *>(strategy))
+        return Stance::Cheater;
+    if (dynamic_cast<AggressivePlayerStrategy *>(strategy) || dynamic_cast<MCTSPlayerStrategy *>(strategy))
+        return Stance::Aggressor;
+    return Stance::Unknown;
+}
+
+vector<int> OutcomeForecaster::distancesFrom(GameEngine &engine, const vector<Territory *> &sources, vector<int> &order)
+{
+    Map *map = engine.getMap();
+    vector<int> distance(map->getTerritoriesSize(), -1);
+    order.clear();
+    for (Territory *source : sources)
+    {
+        if (distance[source->getId()] < 0)
+        {
+            distance[source->getId()] = 0;
+            order.push_back(source->getId());
+        }
+    }
+    for (size_t next = 0; next < order.size(); next++)
+    {
+        int id = order[next];
+        for (Territory *neighbor : map->neighborsOf(id))
+        {
+            if (distance[neighbor->getId()] < 0)
+            {
+                distance[neighbor->getId()] = distance[id] + 1;
+                order.push_back(neighbor->getId());
+            }
+        }
+    }
+    return distance;
+}
+
+Forecast OutcomeForecaster::forecast(GameEngine &engine, int turn, int maxTurns)
+{
+    Forecast result;
+    const vector<Player *> &players = engine.getPlayers();
+    if (!rule.enabled || !engine.getMap() || players.size() < 2 || turn >= maxTurns)
+        return result;
+
+    Player *attacker = nullptr;
+    int attackers = 0;
+    bool onlyPassive = true; // every player but the attacker is Neutral
+    for (Player *player : players)
+    {
+        Stance stance = stanceOf(player);
+        if (stance == Stance::Unknown)
+            return result;
+        if (stance == Stance::Cheater || stance == Stance::Aggressor)
+        {
+            attacker = player;
+            attackers++;
+        }
+        else if (stance != Stance::Passive)
+            onlyPassive = false;
+    }
+
+    if (attackers == 0)
+    {
+        // Benevolent players move only between their own territories, and with nobody
+        // conquering, a move's target is still theirs when it executes
+        result.decided = true;
+        result.endTurn = maxTurns;
+        result.confidence = 1.0;
+        result.basis = "no player can take a territory";
+    }
+    else if (attackers == 1 && stanceOf(attacker) == Stance::Cheater && onlyPassive)
+        result = cheaterSweep(engine, attacker, turn, maxTurns);
+    else if (attackers == 1 && stanceOf(attacker) == Stance::Aggressor)
+        result = aggressorMarch(engine, attacker, turn, maxTurns);
+
+    if (result.decided && result.confidence < rule.minConfidence)
+        result.decided = false;
+    if (result.decided)
+        LOG_NOTIFY(PROGRESSION, "Fast-forward at turn ", turn, ": ",
+                   result.winner ? result.winner->getPlayerName() + " wins" : string("draw"), " at turn ",
+                   result.endTurn, " (confidence ", result.confidence, ", ", result.basis, ")");
+    return result;
+}
+
+Forecast OutcomeForecaster::cheaterSweep(GameEngine &engine, Player *cheater, int turn, int maxTurns)
+{
+    vector<int> order;
+    vector<int> distance = distancesFrom(engine, cheater->getTerritories().toVector(), order);
+
+    // The last enemy territory falls after as many turns as it is moves away
+    int farthest = 0;
+    bool reachable = true;
+    for (Player *player : engine.getPlayers())
+    {
+        if (player == cheater)
+            continue;
+        for (Territory *territory : player->getTerritories())
+        {
+            int moves = distance[territory->getId()];
+            reachable = reachable && moves >= 0;
+            farthest = max(farthest, moves);
+        }
+    }
+
+    Forecast result;
+    result.decided = true;
+    result.confidence = 1.0;
+    if (reachable && turn + farthest <= maxTurns)
+    {
+        result.winner = cheater;
+        result.endTurn = turn + farthest;
+        result.basis = "the Cheater takes every adjacent territory each turn";
+    }
+    else
+    {
+        result.endTurn = maxTurns;
+        result.basis = reachable ? "the Cheater cannot reach every territory in time" : "the Cheater cannot reach every territory";
+    }
+    return result;
+}
+
+Forecast OutcomeForecaster::aggressorMarch(GameEngine &engine, Player *aggressor, int turn, int maxTurns)
+{
+    Forecast result;
+    Territory *strongest = nullptr;
+    for (Territory *territory : aggressor->getTerritories())
+    {
+        if (!strongest || territory->getArmies() > strongest->getArmies())
+            strongest = territory;
+    }
+    if (!strongest)
+        return result;
+
+    vector<int> order;
+    vector<int> distance = distancesFrom(engine, {strongest}, order);
+    Map *map = engine.getMap();
+
+    // One stack, no reinforcements, one battle per turn, nearest territory first
+    double confidence = 1.0;
+    double stack = strongest->getArmies() - 1;
+    int battles = 0;
+    for (int id : order)
+    {
+        Territory *territory = map->getTerritoryById(id);
+        Player *owner = territory->getOwner();
+        const vector<Player *> &players = engine.getPlayers();
+        if (!owner || owner == aggressor || find(players.begin(), players.end(), owner) == players.end())
+            continue; // the aggressor's own, or the blockade neutral's: not needed to win
+        CombatEstimator::Estimate battle = combat.estimate(static_cast<int>(lround(stack)), territory->getArmies());
+        confidence *= battle.winChance;
+        stack = battle.survivors - 1; // one army stays behind on the way
+        battles++;
+        if (confidence < rule.minConfidence)
+            return result;
+    }
+    for (Player *player : engine.getPlayers())
+    {
+        for (Territory *territory : player->getTerritories())
+        {
+            if (distance[territory->getId()] < 0)
+                return result; // out of reach
+        }
+    }
+
+    if (turn + battles > maxTurns)
+        return result;
+    result.decided = true;
+    result.winner = aggressor;
+    result.endTurn = turn + battles;
+    result.confidence = confidence;
+    result.basis = "estimated march of its strongest stack";
+    return result;
+}
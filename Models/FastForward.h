@@ -0,0 +1,79 @@
+#ifndef FAST_FORWARD_H
+#define FAST_FORWARD_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../utils/LoggingObserver.h"
+
+class GameEngine;
+class Player;
+class Territory;
+
+// Optional fast-forward: at the end of a turn, a game whose outcome is already settled
+// is resolved at once with the predicted result instead of being played out.
+struct FastForwardRule
+{
+    bool enabled = false;
+    double minConfidence = 0.95; // statistical forecasts below this keep the game running
+};
+
+// Predicted end of a game
+struct Forecast
+{
+    bool decided = false;
+    Player *winner = nullptr; // nullptr: draw
+    int endTurn = 0;          // turn the game ends on (maxTurns for a draw)
+    double confidence = 0.0;  // 1 when proven, else the estimated chance the winner is right
+    std::string basis;        // why, for the report
+};
+
+// Chance that attackers take a territory from defenders (Advance's battle) and the
+// expected survivors when they do. Estimated by playing the battle a fixed number of
+// times on a private generator seeded from the two stacks, so estimates are
+// reproducible and never touch the game's random stream. Results are cached.
+class CombatEstimator
+{
+public:
+    struct Estimate
+    {
+        double winChance;
+        double survivors; // expected attackers left, given a win
+    };
+
+    explicit CombatEstimator(int samples = 256) : samples(samples) {}
+    Estimate estimate(int attackers, int defenders);
+
+private:
+    int samples;
+    std::unordered_map<uint64_t, Estimate> cache;
+};
+
+// Recognizes decided games. Proven cases:
+//  - no live player ever attacks (Neutral and Benevolent only): a draw at the turn limit
+//  - one Cheater against Neutral players only: it takes every adjacent territory each
+//    turn, so it wins when the farthest enemy territory is reached (a draw if that is
+//    past the turn limit or unreachable)
+// Statistical case: one Aggressive (or MCTS) player against Neutral and Benevolent ones.
+// Its strongest stack marches on the enemy territories nearest first, with no
+// reinforcements; the confidence is the estimated chance it wins every battle.
+// Games with a Human player are never forecast.
+class OutcomeForecaster : public Subject, public ILoggable
+{
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_ENGINE; }
+    explicit OutcomeForecaster(const FastForwardRule &rule) : rule(rule) {}
+    Forecast forecast(GameEngine &engine, int turn, int maxTurns);
+
+private:
+    Forecast cheaterSweep(GameEngine &engine, Player *cheater, int turn, int maxTurns);
+    Forecast aggressorMarch(GameEngine &engine, Player *aggressor, int turn, int maxTurns);
+    // Territory ids by distance (in moves) from the sources, nearest first; -1 if unreachable
+    std::vector<int> distancesFrom(GameEngine &engine, const std::vector<Territory *> &sources, std::vector<int> &order);
+
+    FastForwardRule rule;
+    CombatEstimator combat;
+};
+
+#endif
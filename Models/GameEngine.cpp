@@ -5,11 +5,16 @@
 #include <vector>
 #include <algorithm>
 #include <random>
+#include <memory>
+#include <atomic>
 #include "Map.h"
 #include "Player.h"
 #include "Orders.h"
 #include "Cards.h"
 #include "../utils/logger.h"
+#include "../utils/ProgressMeter.h"
+#include "../utils/WorkStealingPool.h"
+#include "GameLoop.h"
 
 using namespace std;
 const string NEUTRAL_NAME = "NEUTRAL_NAME";
@@ -72,6 +77,8 @@ GameEngine::~GameEngine()
         delete player;
     }
     players.clear();
+    delete neutralPlayer;
+    neutralPlayer = nullptr;
 
     // Clean up map and deck
     if (gameMap != nullptr)
@@ -106,28 +113,35 @@ State *GameEngine::findState(const string &name) const
     return nullptr;
 }
 
-// normalize order of IDs so {1,2} == {2,1}
-static inline pair<int, int> normPair(Player *a, Player *b)
+int GameEngine::slotOf(const Player *player) const
 {
-    int x = a->getId(), y = b->getId();
-    if (x > y)
-        swap(x, y);
-    return {x, y};
+    if (!player)
+        return GameSnapshot::NO_PLAYER;
+    for (size_t slot = 0; slot < players.size(); slot++)
+    {
+        if (players[slot] == player)
+            return static_cast<int>(slot);
+    }
+    return player == neutralPlayer ? static_cast<int>(players.size()) : GameSnapshot::NO_PLAYER;
+}
+
+Player *GameEngine::playerAtSlot(int slot) const
+{
+    if (slot >= 0 && slot < static_cast<int>(players.size()))
+        return players[slot];
+    return slot == static_cast<int>(players.size()) ? neutralPlayer : nullptr;
 }
 
 // record that two players have a truce for the rest of the turn
 void GameEngine::addTruce(Player *a, Player *b)
 {
-    truces.insert(normPair(a, b));
+    truces.add(slotOf(a), slotOf(b));
 }
 
 // check if two players currently have a truce
 bool GameEngine::isTruced(Player *a, Player *b) const
 {
-    auto p = (a->getId() < b->getId())
-                 ? pair<int, int>{a->getId(), b->getId()}
-                 : pair<int, int>{b->getId(), a->getId()};
-    return truces.find(p) != truces.end();
+    return truces.has(slotOf(a), slotOf(b));
 }
 
 // clear truces (call at the start of each new turn)
@@ -184,11 +198,10 @@ bool GameEngine::applyCommand(const string &cmd)
     State *next = current_->nextState(cmd);
     if (!next)
     {
-        logMessage(ERROR, string("Invalid command from state '") + current_->getName() + "'");
-        Notify(this, ERROR, string("Invalid command from state '") + current_->getName() + "'");
+        LOG_NOTIFY(ERROR, "Invalid command from state '", current_->getName(), "'");
         return false;
     }
-    logMessage(INFO, string("Transition: ") + current_->getName() + " -- " + cmd + " ==> " + next->getName());
+    LOG_MESSAGE(INFO, "Transition: ", current_->getName(), " -- ", cmd, " ==> ", next->getName());
     current_ = next;
     Notify(this, INFO, "GameEngine: Current State is: " + (current_ ? current_->getName() : "NULL")); // Added INFO as the messageType for Notify
     return true;
@@ -263,45 +276,25 @@ void GameEngine::reinforcementPhase()
         int territoriesOwned = player->getTerritories().size();
         int armies = std::max(3, territoriesOwned / 3);
 
-        logMessage(INFO, player->getPlayerName() + " owns " +
-                             std::to_string(territoriesOwned) + " territories");
-        logMessage(INFO, "Base reinforcements: " + std::to_string(armies));
-
-        Notify(this, INFO, player->getPlayerName() + " owns " + std::to_string(territoriesOwned) + " territories");
-        Notify(this, INFO, "Base reinforcements: " + std::to_string(armies));
+        LOG_NOTIFY(INFO, player->getPlayerName(), " owns ", territoriesOwned, " territories");
+        LOG_NOTIFY(INFO, "Base reinforcements: ", armies);
 
-        // Add Continent Bonuses
+        // Add Continent Bonuses (owner counters are kept current by Player::transferTerritory)
         if (gameMap != nullptr)
         {
+            gameMap->bindContinentCounters();
             for (Continent &continent : gameMap->getContinents())
             {
-                bool ownsAll = true;
-                std::vector<Territory *> continentTerritories = continent.getTerritories(gameMap);
-
-                for (Territory *territory : continentTerritories)
-                {
-                    if (territory->getOwner() != player)
-                    {
-                        ownsAll = false;
-                        break;
-                    }
-                }
-
-                if (ownsAll && !continentTerritories.empty())
+                if (continent.isControlledBy(player))
                 {
                     int bonus = continent.getBonusValue();
                     armies += bonus;
-                    logMessage(INFO, player->getPlayerName() +
-                                         " controls continent " + continent.getName() +
-                                         " (+" + std::to_string(bonus) + " bonus)");
-                    Notify(this, INFO, player->getPlayerName() + " controls continent " + continent.getName() + " (+" + std::to_string(bonus) + " bonus)");
+                    LOG_NOTIFY(INFO, player->getPlayerName(), " controls continent ", continent.getName(), " (+", bonus, " bonus)");
                 }
             }
         }
         player->setReinforcementPool(armies);
-        logMessage(INFO, player->getPlayerName() + " receives " +
-                             std::to_string(armies) + " armies");
-        Notify(this, INFO, player->getPlayerName() + " receives " + std::to_string(armies) + " armies");
+        LOG_NOTIFY(INFO, player->getPlayerName(), " receives ", armies, " armies");
     }
     logMessage(INFO, "====================================");
 }
@@ -310,164 +303,35 @@ void GameEngine::reinforcementPhase()
 
 void GameEngine::issueOrdersPhase()
 {
-    logMessage(INFO, "====================================");
-    logMessage(INFO, "ISSUING ORDERS PHASE");
-    logMessage(INFO, "====================================");
-
-    std::vector<bool> playersDone(players.size(), false);
-    bool allDone = false;
-    Deck *deck = new Deck();
-    while (!allDone)
-    {
-        allDone = true;
-        for (size_t i = 0; i < players.size(); i++)
-        {
-            if (playersDone[i])
-                continue;
-            Player *player = players[i];
-            // skip players with no territories
-            if (player->getTerritories().empty())
-            {
-                playersDone[i] = true;
-                continue;
-            }
-            logMessage(PROGRESSION, player->getPlayerName() + "'s turn to issue order");
-            Notify(this, PROGRESSION, player->getPlayerName() + "'s turn to issue order");
-
-            bool hasMore = player->issueOrder(gameMap, deck); // Pass the map and deck
-
-            if (!hasMore)
-            {
-                playersDone[i] = true;
-                logMessage(COMBAT, player->getPlayerName() + " has no more orders to issue");
-                Notify(this, COMBAT, player->getPlayerName() + " has no more orders to issue");
-            }
-            else
-            {
-                allDone = false;
-            }
-        }
-    }
-    logMessage(INFO, "\nAll players have finished issuing orders");
-    Notify(this, INFO, "\nAll players have finished issuing orders");
-    logMessage(INFO, "====================================\n");
+    VirtualDispatch dispatch;
+    issueOrdersPhaseWith(dispatch);
 }
 
 // ---------- EXECUTE ORDERS PHASE ----------
 
 void GameEngine::executeOrdersPhase()
 {
-    logMessage(INFO, "====================================");
-    logMessage(INFO, "EXECUTE ORDERS PHASE");
-    logMessage(INFO, "====================================");
-
-    for (Player *player : players)
-    {
-        player->resetConqueredFlag();
-    }
-
-    clearTrucesForNewTurn();
-
-    logMessage(INFO, "\n--- Executing Deploy Orders ---");
-    bool foundDeploy = true;
-
-    while (foundDeploy)
-    {
-        foundDeploy = false;
-        for (Player *player : players)
-        {
-            if (player->getTerritories().empty())
-            {
-                continue;
-            }
-            OrdersList *orderList = player->getOrdersList();
-            // Find first deploy order:
-            for (size_t i = 0; i < orderList->size(); i++)
-            {
-                Order *order = orderList->get(i);
-                Deploy *deployOrder = dynamic_cast<Deploy *>(order);
-                if (deployOrder != nullptr)
-                {
-                    logMessage(INFO, "\nExecuting " + player->getPlayerName() + "'s Deploy order");
-                    Notify(this, INFO, "\nExecuting " + player->getPlayerName() + "'s Deploy order");
-                    order->execute();
-                    logMessage(INFO, "Effect: " + order->getEffect());
-                    Notify(this, INFO, "Effect: " + order->getEffect());
-
-                    orderList->remove(i);
-                    foundDeploy = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    // Execute all other orders in round-robin fashion
-    logMessage(INFO, "\n--- Executing Other Orders (Advance, Bomb, Airlift, etc.) ---");
-    bool foundOtherOrders = true;
-
-    while (foundOtherOrders)
-    {
-        foundOtherOrders = false;
-        for (Player *player : players)
-        {
-            if (player->getTerritories().empty())
-            {
-                continue;
-            }
-            OrdersList *orderList = player->getOrdersList();
-
-            // Execute the first order in the list (which is not a Deploy since they're all gone)
-            if (orderList->size() > 0)
-            {
-                Order *order = orderList->get(0);
-                logMessage(INFO, "\nExecuting " + player->getPlayerName() + "'s order");
-                Notify(this, INFO, "\nExecuting " + player->getPlayerName() + "'s order");
-                order->execute();
-                logMessage(INFO, "Effect: " + order->getEffect());
-                Notify(this, INFO, "Effect: " + order->getEffect());
-
-                orderList->remove(0);
-                foundOtherOrders = true;
-            }
-        }
-    }
-
-    // Give cards to players who conquered at least one territory
-    if (gameDeck != nullptr)
-    {
-        logMessage(INFO, "\n--- Distributing Cards ---");
-        for (Player *player : players)
-        {
-            if (player->hasConqueredThisTurn())
-            {
-                Card *card = gameDeck->draw(*player, *(player->getHandOfCards()));
-                if (card != nullptr)
-                {
-                    player->getHandOfCards()->addCard(card);
-                    logMessage(COMBAT, player->getPlayerName() +
-                                           " conquered territory and receives a card");
-                    Notify(this, COMBAT, player->getPlayerName() + " conquered territory and receives a card");
-                }
-            }
-        }
-    }
-    logMessage(INFO, "====================================\n");
+    VirtualDispatch dispatch;
+    executeOrdersPhaseWith(dispatch);
 }
 
 // ---------- MAIN GAME LOOP ----------
 void GameEngine::mainGameLoop()
 {
+    GameRngScope rngScope(rng);
     logMessage(INFO, "====================================");
     logMessage(INFO, "STARTING MAIN GAME LOOP");
     logMessage(INFO, "====================================\n");
 
     int turnNumber = 1;
+    const int maxTurns = 100;
+    StalemateDetector stalemate(stalemateRule);
+    OutcomeForecaster forecaster(fastForwardRule);
 
     while (true)
     {
         logMessage(INFO, "\n****************************************");
-        logMessage(INFO, "TURN " + std::to_string(turnNumber));
+        LOG_MESSAGE(INFO, "TURN ", turnNumber);
         logMessage(INFO, "****************************************\n");
         // 1. Reinforcement Phase
         reinforcementPhase();
@@ -486,10 +350,9 @@ void GameEngine::mainGameLoop()
         {
             if ((*it)->getTerritories().empty())
             {
-                logMessage(INFO, (*it)->getPlayerName() +
-                                     " has been eliminated (no territories)");
-                Notify(this, INFO, (*it)->getPlayerName() + " has been eliminated (no territories)");
+                LOG_NOTIFY(INFO, (*it)->getPlayerName(), " has been eliminated (no territories)");
                 // remove player from active players
+                truces.removeSlot(static_cast<int>(it - players.begin()));
                 it = players.erase(it);
             }
             else
@@ -510,27 +373,27 @@ void GameEngine::mainGameLoop()
         }
         if (playersWithTerritories == 1)
         {
-            logMessage(INFO, "\n====================================");
-            logMessage(INFO, "GAME OVER!");
-            logMessage(INFO, potentialPlayerWinner->getPlayerName() + " WINS!");
-            logMessage(INFO, "====================================");
-            Notify(this, INFO, "GAME OVER!");
-            Notify(this, INFO, potentialPlayerWinner->getPlayerName() + " WINS!");
+            LOG_MESSAGE(INFO, "\n====================================");
+            LOG_NOTIFY(INFO, "GAME OVER!");
+            LOG_NOTIFY(INFO, potentialPlayerWinner->getPlayerName(), " WINS!");
+            LOG_MESSAGE(INFO, "====================================");
             applyCommand("win");
             break;
         }
         if (playersWithTerritories == 0)
         {
-            logMessage(PROGRESSION, "\nNo players remain with territories. Game ends in a draw.");
-            Notify(this, PROGRESSION, "\nNo players remain with territories. Game ends in a draw.");
+            LOG_NOTIFY(PROGRESSION, "\nNo players remain with territories. Game ends in a draw.");
             break;
         }
+        if (stalemate.endTurn(*this, turnNumber))
+            break;
+        if (fastForwardRule.enabled && forecaster.forecast(*this, turnNumber, maxTurns).decided)
+            break; // the forecaster has logged the predicted result
         turnNumber++;
 
-        if (turnNumber > 100)
+        if (turnNumber > maxTurns)
         {
-            logMessage(WARNING, "Woho, Limit reached pal. End Game.");
-            Notify(this, WARNING, "Woho, Limit reached pal. End Game.");
+            LOG_NOTIFY(WARNING, "Woho, Limit reached pal. End Game.");
             break;
         }
     }
@@ -539,6 +402,7 @@ void GameEngine::mainGameLoop()
 // ---------- STARTUP PHASE ----------
 void GameEngine::startupPhase()
 {
+    GameRngScope rngScope(rng);
     string input, command, argument;
     bool mapLoaded = false;
     bool mapValidated = false;
@@ -587,15 +451,12 @@ void GameEngine::startupPhase()
             gameMap = map_loader.loadMap(argument); // Load map file
             if (gameMap == nullptr)
             {
-                logMessage(ERROR, "Error: Failed to load map.");
-                logMessage(DEBUG, argument);
-                Notify(this, ERROR, "Error: Failed to load map.");
-                Notify(this, DEBUG, argument);
+                LOG_NOTIFY(ERROR, "Error: Failed to load map.");
+                LOG_NOTIFY(DEBUG, argument);
                 continue;
             }
 
-            logMessage(INFO, string("Map '") + argument + "' loaded successfully.");
-            Notify(this, INFO, string("Map '") + argument + "' loaded successfully.");
+            LOG_NOTIFY(INFO, "Map '", argument, "' loaded successfully.");
             mapLoaded = true;
             applyCommand("loadmap");
         }
@@ -612,15 +473,13 @@ void GameEngine::startupPhase()
             bool isMapValidated = gameMap->validate();
             if (isMapValidated)
             {
-                logMessage(INFO, "Map validated successfully.");
-                Notify(this, INFO, "Map validated successfully.");
+                LOG_NOTIFY(INFO, "Map validated successfully.");
                 mapValidated = true;
                 applyCommand("validatemap");
             }
             else
             {
-                logMessage(ERROR, "Map validation failed. Please check the map file.");
-                Notify(this, ERROR, "Map validation failed. Please check the map file.");
+                LOG_NOTIFY(ERROR, "Map validation failed. Please check the map file.");
             }
         }
 
@@ -652,8 +511,7 @@ void GameEngine::startupPhase()
 
             if (it != players.end())
             {
-                logMessage(ERROR, string("Player '") + argument + "' already added.");
-                Notify(this, ERROR, string("Player '") + argument + "' already added.");
+                LOG_NOTIFY(ERROR, "Player '", argument, "' already added.");
                 continue;
             }
             if (players.size() > 6)
@@ -665,8 +523,7 @@ void GameEngine::startupPhase()
             // Create new player and add to list
             Player *newPlayer = new Player(argument);
             players.push_back(newPlayer);
-            logMessage(INFO, string("Player '") + newPlayer->getPlayerName() + "' added.");
-            Notify(this, INFO, string("Player '") + newPlayer->getPlayerName() + "' added.");
+            LOG_NOTIFY(INFO, "Player '", newPlayer->getPlayerName(), "' added.");
             applyCommand("addplayer");
         }
         else if (command == "gamestart")
@@ -676,12 +533,11 @@ void GameEngine::startupPhase()
                 logMessage(ERROR, "You need between 2 and 6 players before starting.");
                 continue;
             }
-            logMessage(PROGRESSION, string("=== Starting the game with ") + to_string(players.size()) + " players ===");
+            LOG_MESSAGE(PROGRESSION, "=== Starting the game with ", players.size(), " players ===");
             Notify(this, PROGRESSION, "GAME STARTED with players: " + to_string(players.size()));
             for (const auto *p : players)
             {
-                logMessage(INFO, string("  - ") + p->getPlayerName());
-                Notify(this, INFO, string("  - ") + p->getPlayerName());
+                LOG_NOTIFY(INFO, "  - ", p->getPlayerName());
             }
             // 4a. Distribute territories fairly among players
             logMessage(INFO, "4a) Distributing territories equally among players...");
@@ -691,14 +547,11 @@ void GameEngine::startupPhase()
             // 4b. Determine random order of play
             logMessage(INFO, "4b) Determining random order of play...");
             Notify(this, INFO, "Determining random order of play");
-            random_device rd;
-            mt19937 g(rd());
-            shuffle(players.begin(), players.end(), g);
+            shuffle(players.begin(), players.end(), rng);
             logMessage(INFO, "Order of play:");
             for (size_t i = 0; i < players.size(); ++i)
             {
-                logMessage(INFO, string("  ") + to_string(i + 1) + ". " + players[i]->getPlayerName());
-                Notify(this, INFO, string("  ") + to_string(i + 1) + ". " + players[i]->getPlayerName());
+                LOG_NOTIFY(INFO, "  ", i + 1, ". ", players[i]->getPlayerName());
             }
 
             // 4c. Give 50 initial army units to each player's reinforcement pool
@@ -707,8 +560,7 @@ void GameEngine::startupPhase()
             for (auto *p : players)
             {
                 p->setReinforcementPool(50);
-                logMessage(COMBAT, string("  ") + p->getPlayerName() + " receives 50 armies.");
-                Notify(this, COMBAT, string("  ") + p->getPlayerName() + " receives 50 armies.");
+                LOG_NOTIFY(COMBAT, "  ", p->getPlayerName(), " receives 50 armies.");
             }
 
             // 4d. Let each player draw 2 initial cards from the deck
@@ -718,18 +570,15 @@ void GameEngine::startupPhase()
             {
                 gameDeck->draw(*p, *(p->getHandOfCards()));
                 gameDeck->draw(*p, *(p->getHandOfCards()));
-                logMessage(PROGRESSION, string("  ") + p->getPlayerName() + " drew 2 cards.");
-                Notify(this, PROGRESSION, string("  ") + p->getPlayerName() + " drew 2 cards.");
+                LOG_NOTIFY(PROGRESSION, "  ", p->getPlayerName(), " drew 2 cards.");
             }
 
             // 4e. Switch to play phase
             logMessage(INFO, "4e) Switching to play phase!");
             Notify(this, INFO, "Switching to play phase!");
             applyCommand("gamestart");
-            logMessage(INFO, "Transitioned to assign_reinforcement state.");
-            Notify(this, INFO, "Transitioned to assign_reinforcement state.");
-            logMessage(INFO, "Play phase started! (Next valid command: 'issueorder')");
-            Notify(this, INFO, "Play phase started! (Next valid command: 'issueorder')");
+            LOG_NOTIFY(INFO, "Transitioned to assign_reinforcement state.");
+            LOG_NOTIFY(INFO, "Play phase started! (Next valid command: 'issueorder')");
             break;
         }
 
@@ -747,219 +596,198 @@ void GameEngine::startupPhase()
 void GameEngine::runTournament(const vector<string> &mapFiles,
                                const vector<string> &strategies,
                                int numGames,
-                               int maxTurns)
+                               int maxTurns,
+                               int numThreads,
+                               long long seed,
+                               const string &recordFile)
 {
     logMessage(INFO, "====================================");
-    logMessage(INFO, "STARTING TOURNAMENT MODE");
-    Notify(this, INFO, "STARTING TOURNAMENT MODE");
+    LOG_NOTIFY(INFO, "STARTING TOURNAMENT MODE");
     logMessage(INFO, "====================================");
 
-    logMessage(INFO, "Tournament Parameters:");
-    Notify(this, INFO, "Tournament Parameters:");
-    logMessage(INFO, "Maps:");
-    Notify(this, INFO, "Maps:");
+    LOG_NOTIFY(INFO, "Tournament Parameters:");
+    LOG_NOTIFY(INFO, "Maps:");
 
     for (const auto &map : mapFiles)
     {
-        logMessage(INFO, "  - " + map);
-        Notify(this, INFO, "  - " + map);
+        LOG_NOTIFY(INFO, "  - ", map);
     }
 
     logMessage(INFO, "Strategies:");
     for (const auto &s : strategies)
     {
-        logMessage(INFO, "  - " + s);
-        Notify(this, INFO, "  - " + s);
+        LOG_NOTIFY(INFO, "  - ", s);
     }
 
-    logMessage(INFO, "Games per map: " + to_string(numGames));
-    Notify(this, INFO, "Games per map: " + to_string(numGames));
-    logMessage(INFO, "Max turns: " + to_string(maxTurns));
-    Notify(this, INFO, "Max turns: " + to_string(maxTurns));
+    LOG_NOTIFY(INFO, "Games per map: ", numGames);
+    LOG_NOTIFY(INFO, "Max turns: ", maxTurns);
+
+    // Without -S a seed is drawn once and logged, so any run can be replayed
+    uint64_t tournamentSeed = seed >= 0 ? static_cast<uint64_t>(seed) : randomSeed() >> 1;
+    LOG_NOTIFY(INFO, "Seed: ", tournamentSeed);
+
+    unique_ptr<RecordingWriter> recordings;
+    if (!recordFile.empty())
+    {
+        recordings.reset(new RecordingWriter(recordFile));
+        if (recordings->isOpen())
+            LOG_NOTIFY(INFO, "Recording games to ", recordFile);
+        else
+            recordings.reset();
+    }
+    if (stalemateRule.enabled())
+        LOG_NOTIFY(INFO, "Early draws: ", stalemateRule.window, " quiet turns, ", stalemateRule.repeats,
+                   " repeated positions (0 = off)");
+    if (fastForwardRule.enabled)
+        LOG_NOTIFY(INFO, "Fast-forward: decided games resolved at confidence ", fastForwardRule.minConfidence);
 
-    // Results table: results[mapIndex][gameIndex] = winner
+    // Results table: results[mapIndex][gameIndex] = winner, with why a game ended early
     vector<vector<string>> results(
         mapFiles.size(),
         vector<string>(numGames, "Draw"));
+    vector<vector<string>> earlyEnds(mapFiles.size(), vector<string>(numGames));
+    atomic<long long> turnsPlayed(0);
+
+    // One game, recorded when asked; safe to call from any worker thread
+    auto playGame = [&](size_t mapIdx, int gameIdx)
+    {
+        TournamentDispatch dispatch;
+        GameRecorder recorder;
+        GameResult result = runGameWith(dispatch, mapFiles[mapIdx], strategies, maxTurns, tournamentSeed,
+                                        mapIdx * numGames + gameIdx, recordings ? &recorder : nullptr);
+        if (recordings)
+            recordings->write(recorder.getRecording());
+        earlyEnds[mapIdx][gameIdx] = result.endReason;
+        turnsPlayed += result.turns;
+        return result.winner;
+    };
+
+    // Precompile each map once so every game loads the binary form instead of reparsing the text.
+    // A map that cannot be converted is still played from its .map file.
+    MapLoader precompiler;
+    for (const auto &mapFile : mapFiles)
+    {
+        if (!precompiler.hasFreshBinary(mapFile) && !precompiler.convertToBinary(mapFile))
+        {
+            LOG_NOTIFY(WARNING, "Could not precompile map: ", mapFile);
+        }
+    }
+
+    // Status line for --progress; a no-op in the default console mode
+    ProgressMeter progress("games", static_cast<int>(mapFiles.size()) * numGames);
+
+    if (numThreads > 1)
+    {
+        LOG_NOTIFY(INFO, "Worker threads: ", numThreads);
+
+        // Every (map, game) pair is an independent game with its own engine,
+        // so each one is a task; winners land in their own results cell.
+        WorkStealingPool pool(numThreads);
+        for (size_t mapIdx = 0; mapIdx < mapFiles.size(); mapIdx++)
+        {
+            for (int gameIdx = 0; gameIdx < numGames; gameIdx++)
+            {
+                pool.submit([this, &results, &mapFiles, &progress, &playGame, mapIdx, gameIdx, numGames]()
+                            {
+                    results[mapIdx][gameIdx] = playGame(mapIdx, gameIdx);
+
+                    LOG_NOTIFY(INFO, mapFiles[mapIdx], " game ", gameIdx + 1, "/", numGames,
+                               ": Result = ", results[mapIdx][gameIdx]);
+                    progress.advance(); });
+            }
+        }
+        pool.waitAll();
+        progress.finish();
+
+        LOG_NOTIFY(INFO, "Turns played: ", turnsPlayed.load());
+        generateTournamentReport(results, mapFiles, strategies, numGames, maxTurns, earlyEnds);
+        return;
+    }
 
     // Play tournament
     for (size_t mapIdx = 0; mapIdx < mapFiles.size(); mapIdx++)
     {
-        logMessage(PROGRESSION, "Playing on map: " + mapFiles[mapIdx]);
-        Notify(this, PROGRESSION, "Playing on map: " + mapFiles[mapIdx]);
+        LOG_NOTIFY(PROGRESSION, "Playing on map: ", mapFiles[mapIdx]);
 
         for (int gameIdx = 0; gameIdx < numGames; gameIdx++)
         {
-            logMessage(INFO, "Game " + to_string(gameIdx + 1) + "/" + to_string(numGames));
-            Notify(this, INFO, "Game " + to_string(gameIdx + 1) + "/" + to_string(numGames));
+            LOG_NOTIFY(INFO, "Game ", gameIdx + 1, "/", numGames);
 
-            results[mapIdx][gameIdx] =
-                runSingleGame(mapFiles[mapIdx], strategies, maxTurns);
+            results[mapIdx][gameIdx] = playGame(mapIdx, gameIdx);
 
-            logMessage(INFO, "Result = " + results[mapIdx][gameIdx]);
-            Notify(this, INFO, "Result = " + results[mapIdx][gameIdx]);
+            LOG_NOTIFY(INFO, "Result = ", results[mapIdx][gameIdx]);
+            progress.advance();
         }
     }
+    progress.finish();
 
     // Print final tournament results
-    generateTournamentReport(results, mapFiles, strategies, numGames, maxTurns);
+    LOG_NOTIFY(INFO, "Turns played: ", turnsPlayed.load());
+    generateTournamentReport(results, mapFiles, strategies, numGames, maxTurns, earlyEnds);
 }
 
-string GameEngine::runSingleGame(const string &mapFile,
-                                 const vector<string> &strategies,
-                                 int maxTurns)
+bool GameEngine::setupGame(const string &mapFile, const vector<string> &strategies)
 {
-    logMessage(EVENT, "Building Game engine. . .");
-    Notify(this, EVENT, "Building Game engine. . .");
-    GameEngine game;
-    game.buildGraph();
-    logMessage(EVENT, "GameEngine built!");
-    Notify(this, EVENT, "Building Game engine. . .");
+    if (strategies.size() > static_cast<size_t>(MAX_PLAYERS))
+    {
+        LOG_NOTIFY(ERROR, "Too many players: ", strategies.size(), " (at most ", static_cast<int>(MAX_PLAYERS), ")");
+        return false;
+    }
 
     // Load map
     MapLoader loader;
-    game.gameMap = loader.loadMap(mapFile);
+    gameMap = loader.loadMap(mapFile);
 
-    if (!game.gameMap)
+    if (!gameMap)
     {
-        logMessage(ERROR, "Map load failed: " + mapFile);
-        Notify(this, ERROR, "Map load failed: " + mapFile);
-        return "Error";
+        LOG_NOTIFY(ERROR, "Map load failed: ", mapFile);
+        return false;
     }
-    if (!game.gameMap->validate())
+    if (!gameMap->validate())
     {
-        logMessage(ERROR, "Map validation failed: " + mapFile);
-        Notify(this, ERROR, "Map validation failed: " + mapFile);
-        delete game.gameMap;
-        return "Error";
+        LOG_NOTIFY(ERROR, "Map validation failed: ", mapFile);
+        delete gameMap;
+        gameMap = nullptr;
+        return false;
     }
 
-    // Create players with basic behavior (no strategies yet)
+    // Create players; an unrecognized strategy name gets a Human player
     for (size_t i = 0; i < strategies.size(); i++)
     {
         Player *p = new Player(strategies[i] + "_Player");
-
-        if (strategies[i] == "Aggressive")
-        {
-            p->setStrategy(new AggressivePlayerStrategy());
-        }
-        else if (strategies[i] == "Benevolent")
-        {
-            p->setStrategy(new BenevolentPlayerStrategy());
-        }
-        else if (strategies[i] == "Neutral")
-        {
-            p->setStrategy(new NeutralPlayerStrategy());
-        }
-        else if (strategies[i] == "Cheater")
-        {
-            p->setStrategy(new CheaterPlayerStrategy());
-        }
-        else
-        {
-            // Default to Human if strategy name not recognized
-            p->setStrategy(new HumanPlayerStrategy());
-        }
-        game.players.push_back(p);
+        p->setStrategy(createStrategy(strategies[i], this));
+        players.push_back(p);
     }
 
     // Automated startup
-    game.gameMap->distributeTerritories(game.players);
+    gameMap->distributeTerritories(players);
 
     // Shuffle player order
-    random_device rd;
-    mt19937 g(rd());
-    shuffle(game.players.begin(), game.players.end(), g);
+    shuffle(players.begin(), players.end(), rng);
 
     // Create deck if missing
-    if (!game.gameDeck)
-        game.gameDeck = new Deck();
+    if (!gameDeck)
+        gameDeck = new Deck();
 
-    for (auto *p : game.players)
+    for (auto *p : players)
     {
         p->setReinforcementPool(50);
-        game.gameDeck->draw(*p, *(p->getHandOfCards()));
-        game.gameDeck->draw(*p, *(p->getHandOfCards()));
-    }
-    logMessage(EVENT, "GAME START!");
-    Notify(this, EVENT, "GAME START");
-    game.applyCommand("gamestart");
-
-    // Main loop with turn limit
-    int turn = 1;
-    bool finished = false;
-    string winner = "Draw";
-
-    while (!finished && turn <= maxTurns)
-    {
-        game.reinforcementPhase();
-        game.issueOrdersPhase();
-        game.executeOrdersPhase();
-
-        // Remove eliminated players
-        auto it = game.players.begin();
-        while (it != game.players.end())
-        {
-            if ((*it)->getTerritories().empty())
-            {
-                logMessage(WARNING, (*it)->getPlayerName() + " eliminated!");
-                Notify(this, WARNING, (*it)->getPlayerName() + " eliminated!");
-                delete *it; // Delete the eliminated player
-                it = game.players.erase(it);
-            }
-            else
-                ++it;
-        }
-
-        logMessage(DEBUG, "Turn " + to_string(turn) + ": " + to_string(game.players.size()) + " players remaining");
-
-        // Win check - extract strategy name from player name
-        if (game.players.size() == 1)
-        {
-            string winnerName = game.players[0]->getPlayerName();
-            // Extract strategy name (remove "_Player" suffix)
-            size_t pos = winnerName.find("_Player");
-            if (pos != string::npos)
-            {
-                winner = winnerName.substr(0, pos);
-            }
-            else
-            {
-                winner = winnerName;
-            }
-            finished = true;
-        }
-        else if (game.players.empty())
-        {
-            winner = "Draw";
-            finished = true;
-        }
-
-        turn++;
-    }
-
-    // Only set to draw if game wasn't finished (no winner determined)
-    if (!finished && turn > maxTurns)
-        winner = "Draw";
-
-    // Cleanup - delete remaining players manually
-    for (auto *p : game.players)
-        delete p;
-    game.players.clear();
-
-    // Delete map and deck, then set to nullptr to prevent double-delete in destructor
-    if (game.gameMap)
-    {
-        delete game.gameMap;
-        game.gameMap = nullptr;
-    }
-    if (game.gameDeck)
-    {
-        delete game.gameDeck;
-        game.gameDeck = nullptr;
+        gameDeck->draw(*p, *(p->getHandOfCards()));
+        gameDeck->draw(*p, *(p->getHandOfCards()));
     }
+    LOG_NOTIFY(EVENT, "GAME START!");
+    applyCommand("gamestart");
+    return true;
+}
 
-    return winner;
+string GameEngine::runSingleGame(const string &mapFile,
+                                 const vector<string> &strategies,
+                                 int maxTurns,
+                                 uint64_t seed,
+                                 uint64_t stream)
+{
+    VirtualDispatch dispatch;
+    return runGameWith(dispatch, mapFile, strategies, maxTurns, seed, stream).winner;
 }
 
 void GameEngine::generateTournamentReport(
@@ -967,7 +795,8 @@ void GameEngine::generateTournamentReport(
     const vector<string> &mapFiles,
     const vector<string> &strategies,
     int numGames,
-    int maxTurns)
+    int maxTurns,
+    const vector<vector<string>> &earlyEnds)
 {
 
     cout << "\n\n====================================\n";
@@ -1041,5 +870,20 @@ void GameEngine::generateTournamentReport(
         cout << "\n";
     }
 
+    // Games a StalemateRule or a fast-forward ended early
+    bool header = false;
+    for (size_t m = 0; m < earlyEnds.size(); m++)
+    {
+        for (size_t g = 0; g < earlyEnds[m].size(); g++)
+        {
+            if (earlyEnds[m][g].empty())
+                continue;
+            if (!header)
+                cout << "\nEnded early:\n";
+            header = true;
+            cout << "  " << mapFiles[m] << " game " << g + 1 << ": " << earlyEnds[m][g] << "\n";
+        }
+    }
+
     logMessage(EVENT, "Tournament results displayed successfully.");
 }
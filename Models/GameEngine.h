@@ -5,9 +5,13 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <unordered_set>
 #include <utility>
 #include <iostream>
+#include "GameSnapshot.h"
+#include "Stalemate.h"
+#include "FastForward.h"
+#include "TruceMatrix.h"
+#include "../utils/GameRng.h"
 #include "../utils/LoggingObserver.h"
 using namespace std;
 
@@ -15,6 +19,17 @@ using namespace std;
 class Player;
 class Deck;
 class Map;
+class GameRecorder;
+
+// How one automated game ended
+struct GameResult
+{
+    string winner = "Draw"; // strategy name, "Draw" or "Error"
+    string endReason;       // set when a StalemateRule or a fast-forward ended the game early
+    int turns = 0;          // turns played, or the forecast's last turn when fast-forwarded
+    bool forecast = false;  // the result was predicted, not played out
+    double confidence = 1.0;
+};
 
 class State
 {
@@ -39,6 +54,7 @@ private:
 class GameEngine : public Subject, public ILoggable
 {
 public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_ENGINE; }
     GameEngine();
     GameEngine(const GameEngine &other);
     GameEngine &operator=(const GameEngine &other);
@@ -52,33 +68,97 @@ public:
     void startupPhase();
     Player *getNeutralPlayer();
     void addTruce(Player *a, Player *b);
-    bool isTruced(Player *a, Player *b) const;
+    bool isTruced(Player *a, Player *b) const; // O(1) once both slots are known
     void clearTrucesForNewTurn();
 
+    // Player slots as in GameSnapshot: the players in list order, then the neutral player.
+    // slotOf gives NO_PLAYER for anyone else, playerAtSlot nullptr for an unused slot.
+    // Truces are kept by slot, so a game holds at most MAX_PLAYERS plus the neutral player.
+    static const int MAX_PLAYERS = TruceMatrix::MAX_SLOTS - 1;
+    int slotOf(const Player *player) const;
+    Player *playerAtSlot(int slot) const;
+
+    // Every random draw of this game (dice, shuffles, card draws) comes from this generator
+    GameRng &getRng() { return rng; }
+    void setSeed(uint64_t seed, uint64_t stream = 0) { rng.reseed(seed, stream); }
+
+    // Early draws for mainGameLoop and every game this engine runs (see Stalemate.h)
+    void setStalemateRule(const StalemateRule &rule) { stalemateRule = rule; }
+    const StalemateRule &getStalemateRule() const { return stalemateRule; }
+    // Decided games resolved at once with the predicted result (see FastForward.h)
+    void setFastForwardRule(const FastForwardRule &rule) { fastForwardRule = rule; }
+    const FastForwardRule &getFastForwardRule() const { return fastForwardRule; }
+
+    // Snapshots for what-if play (see GameSnapshot.h)
+    GameSnapshot snapshot() const;
+    bool restore(const GameSnapshot &snapshot); // false, and nothing changed, if it does not fit this game
+    GameEngine *fork() const;                   // independent copy with its own map, players and deck
+
+    // Automated setup as in tournament games: loads and validates the map, adds one player
+    // per strategy name, distributes territories and deals the starting armies and cards
+    bool setupGame(const string &mapFile, const vector<string> &strategies);
+    const vector<Player *> &getPlayers() const { return players; }
+    void addPlayer(Player *player) { players.push_back(player); } // the engine deletes it
+    Map *getMap() const { return gameMap; }
+
     // Assignment 2 – Part 3: Main Game Loop
     void mainGameLoop();
     void reinforcementPhase();
     void issueOrdersPhase();
     void executeOrdersPhase();
 
+    // Same phases over a dispatch policy (VirtualDispatch, StaticDispatch; see GameLoop.h)
+    template <typename Dispatch>
+    void issueOrdersPhaseWith(Dispatch &dispatch);
+    template <typename Dispatch>
+    void executeOrdersPhaseWith(Dispatch &dispatch);
+
     friend ostream &operator<<(ostream &os, const GameEngine &ge);
     // Assignment 3 - Part 2
     void runTournament(const vector<string> &mapFiles,
                        const vector<string> &strategies,
                        int numGames,
-                       int maxTurns);
+                       int maxTurns,
+                       int numThreads = 1,             // numThreads > 1 plays games on a work-stealing pool
+                       long long seed = -1,            // game g of map m uses stream m * numGames + g; -1 = random seed
+                       const string &recordFile = ""); // non-empty: every game is recorded there (see GameRecord.h)
 
     string runSingleGame(const string &mapFile,
                          const vector<string> &strategies,
-                         int maxTurns);
+                         int maxTurns,
+                         uint64_t seed,
+                         uint64_t stream);
+
+    // runSingleGame with the strategy types known at compile time (defined in GameLoop.h):
+    // same game, same result, strategies and orders called without virtual dispatch
+    template <typename... Strategies>
+    string runTypedGame(const string &mapFile,
+                        const vector<string> &strategies,
+                        int maxTurns,
+                        uint64_t seed,
+                        uint64_t stream);
 
     void generateTournamentReport(const vector<vector<string>> &results,
                                   const vector<string> &mapFiles,
                                   const vector<string> &strategies,
                                   int numGames,
-                                  int maxTurns);
+                                  int maxTurns,
+                                  const vector<vector<string>> &earlyEnds = {});
 
 private:
+    template <typename Dispatch>
+    GameResult runGameWith(Dispatch &dispatch,
+                           const string &mapFile,
+                           const vector<string> &strategies,
+                           int maxTurns,
+                           uint64_t seed,
+                           uint64_t stream,
+                           GameRecorder *recorder = nullptr);
+
+    // Read the engine's state directly to record games and rebuild them
+    friend class GameRecorder;
+    friend class ReplayEngine;
+
     void clear();
     State *findState(const string &name) const;
 
@@ -88,14 +168,10 @@ private:
     Player *neutralPlayer = nullptr;
     Map *gameMap = nullptr;
     Deck *gameDeck = nullptr;
-    struct PairHash
-    {
-        size_t operator()(const pair<int, int> &p) const
-        {
-            return (static_cast<size_t>(p.first) << 32) ^ static_cast<size_t>(p.second);
-        }
-    };
-    unordered_set<pair<int, int>, PairHash> truces;
+    GameRng rng;
+    StalemateRule stalemateRule;
+    FastForwardRule fastForwardRule;
+    TruceMatrix truces; // by player slot; an eliminated player's slot is removed with it
 };
 
 #endif
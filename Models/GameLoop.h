@@ -0,0 +1,393 @@
+#ifndef GAME_LOOP_H
+#define GAME_LOOP_H
+
+#include <vector>
+#include "GameEngine.h"
+#include "Map.h"
+#include "Player.h"
+#include "Orders.h"
+#include "Cards.h"
+#include "GameRecord.h"
+#include "../PlayerStrategies/PlayerStrategies.h"
+#include "../utils/logger.h"
+
+// Dispatch policies for the game loop templates in GameEngine. A policy decides how a
+// player's strategy is asked for an order and how an order is executed; the phases
+// and the rules are shared, so every policy plays exactly the same game.
+
+// The usual path: virtual PlayerStrategy::issueOrder and Order::execute
+struct VirtualDispatch
+{
+    void bind(const vector<Player *> &) {}
+    void removePlayer(size_t) {}
+    bool issueOrder(size_t, Player *player, Map *map, Deck *deck) { return player->issueOrder(map, deck); }
+    void execute(Order *order) { order->execute(); }
+};
+
+// Strategy mix fixed at compile time: each player's strategy is matched once against
+// Strategies (all final classes) and then called directly, and orders are executed
+// through a switch on their kind. A strategy outside the list keeps the virtual call.
+template <typename... Strategies>
+class StaticDispatch
+{
+public:
+    void bind(const vector<Player *> &players)
+    {
+        typeOf.clear();
+        for (Player *player : players)
+            typeOf.push_back(indexOf(player->getStrategy()));
+    }
+
+    void removePlayer(size_t slot) { typeOf.erase(typeOf.begin() + slot); }
+
+    bool issueOrder(size_t slot, Player *player, Map *map, Deck *deck)
+    {
+        int type = typeOf[slot];
+        if (type < 0)
+            return player->issueOrder(map, deck);
+
+        PlayerStrategy *strategy = player->getStrategy();
+        bool more = false;
+        int index = 0;
+        ((type == index++ && (more = static_cast<Strategies *>(strategy)->issueOrder(player, map, deck), true)) || ...);
+        return more;
+    }
+
+    void execute(Order *order)
+    {
+        switch (order->kind())
+        {
+        case OrderKind::Deploy:
+            static_cast<Deploy *>(order)->execute();
+            break;
+        case OrderKind::Advance:
+            static_cast<Advance *>(order)->execute();
+            break;
+        case OrderKind::Bomb:
+            static_cast<Bomb *>(order)->execute();
+            break;
+        case OrderKind::Blockade:
+            static_cast<Blockade *>(order)->execute();
+            break;
+        case OrderKind::Airlift:
+            static_cast<Airlift *>(order)->execute();
+            break;
+        case OrderKind::Negotiate:
+            static_cast<Negotiate *>(order)->execute();
+            break;
+        }
+    }
+
+private:
+    static int indexOf(PlayerStrategy *strategy)
+    {
+        int found = -1;
+        int index = 0;
+        ((found < 0 && dynamic_cast<Strategies *>(strategy) ? found = index : 0, index++), ...);
+        return found;
+    }
+
+    vector<int> typeOf; // per player slot: index into Strategies, -1 for the virtual call
+};
+
+// Every AI strategy a tournament can name; Human and MCTS keep the virtual call
+using TournamentDispatch = StaticDispatch<AggressivePlayerStrategy, BenevolentPlayerStrategy,
+                                          NeutralPlayerStrategy, CheaterPlayerStrategy>;
+
+template <typename... Strategies>
+string GameEngine::runTypedGame(const string &mapFile,
+                                const vector<string> &strategies,
+                                int maxTurns,
+                                uint64_t seed,
+                                uint64_t stream)
+{
+    StaticDispatch<Strategies...> dispatch;
+    return runGameWith(dispatch, mapFile, strategies, maxTurns, seed, stream).winner;
+}
+
+// ---------- ISSUING ORDERS PHASE ----------
+
+template <typename Dispatch>
+void GameEngine::issueOrdersPhaseWith(Dispatch &dispatch)
+{
+    logMessage(INFO, "====================================");
+    logMessage(INFO, "ISSUING ORDERS PHASE");
+    logMessage(INFO, "====================================");
+
+    std::vector<bool> playersDone(players.size(), false);
+    bool allDone = false;
+    Deck deck; // scratch deck for cards played while issuing
+    while (!allDone)
+    {
+        allDone = true;
+        for (size_t i = 0; i < players.size(); i++)
+        {
+            if (playersDone[i])
+                continue;
+            Player *player = players[i];
+            // skip players with no territories
+            if (player->getTerritories().empty())
+            {
+                playersDone[i] = true;
+                continue;
+            }
+            LOG_NOTIFY(PROGRESSION, player->getPlayerName(), "'s turn to issue order");
+
+            bool hasMore = dispatch.issueOrder(i, player, gameMap, &deck); // Pass the map and deck
+
+            if (!hasMore)
+            {
+                playersDone[i] = true;
+                LOG_NOTIFY(COMBAT, player->getPlayerName(), " has no more orders to issue");
+            }
+            else
+            {
+                allDone = false;
+            }
+        }
+    }
+    if (GameRecorder *recorder = activeRecorderFor(this))
+        recorder->sync(); // cards played while issuing
+    LOG_NOTIFY(INFO, "\nAll players have finished issuing orders");
+    logMessage(INFO, "====================================\n");
+}
+
+// ---------- EXECUTE ORDERS PHASE ----------
+
+template <typename Dispatch>
+void GameEngine::executeOrdersPhaseWith(Dispatch &dispatch)
+{
+    logMessage(INFO, "====================================");
+    logMessage(INFO, "EXECUTE ORDERS PHASE");
+    logMessage(INFO, "====================================");
+    GameRecorder *recorder = activeRecorderFor(this);
+
+    for (Player *player : players)
+    {
+        player->resetConqueredFlag();
+    }
+
+    clearTrucesForNewTurn();
+
+    logMessage(INFO, "\n--- Executing Deploy Orders ---");
+    bool foundDeploy = true;
+
+    while (foundDeploy)
+    {
+        foundDeploy = false;
+        for (Player *player : players)
+        {
+            if (player->getTerritories().empty())
+            {
+                continue;
+            }
+            OrdersList *orderList = player->getOrdersList();
+            // First deploy order still queued:
+            Order *order = orderList->nextDeploy();
+            if (order != nullptr)
+            {
+                LOG_NOTIFY(INFO, "\nExecuting ", player->getPlayerName(), "'s Deploy order");
+                if (recorder)
+                    recorder->beforeOrder(order);
+                dispatch.execute(order);
+                if (recorder)
+                    recorder->afterOrder(order);
+                LOG_NOTIFY(INFO, "Effect: ", order->getEffect());
+
+                orderList->popDeploy();
+                foundDeploy = true;
+            }
+        }
+    }
+
+    // Execute all other orders in round-robin fashion
+    logMessage(INFO, "\n--- Executing Other Orders (Advance, Bomb, Airlift, etc.) ---");
+    bool foundOtherOrders = true;
+
+    while (foundOtherOrders)
+    {
+        foundOtherOrders = false;
+        for (Player *player : players)
+        {
+            if (player->getTerritories().empty())
+            {
+                continue;
+            }
+            OrdersList *orderList = player->getOrdersList();
+
+            // Execute the first non-deploy order (the deploys are all gone)
+            Order *order = orderList->nextOther();
+            if (order != nullptr)
+            {
+                LOG_NOTIFY(INFO, "\nExecuting ", player->getPlayerName(), "'s order");
+                if (recorder)
+                    recorder->beforeOrder(order);
+                dispatch.execute(order);
+                if (recorder)
+                    recorder->afterOrder(order);
+                LOG_NOTIFY(INFO, "Effect: ", order->getEffect());
+
+                orderList->popOther();
+                foundOtherOrders = true;
+            }
+        }
+    }
+
+    // Give cards to players who conquered at least one territory
+    if (gameDeck != nullptr)
+    {
+        logMessage(INFO, "\n--- Distributing Cards ---");
+        for (Player *player : players)
+        {
+            if (player->hasConqueredThisTurn())
+            {
+                Card *card = gameDeck->draw(*player, *(player->getHandOfCards()));
+                if (card != nullptr)
+                {
+                    player->getHandOfCards()->addCard(card);
+                    LOG_NOTIFY(COMBAT, player->getPlayerName(), " conquered territory and receives a card");
+                }
+            }
+        }
+    }
+    if (recorder)
+        recorder->endTurn();
+    logMessage(INFO, "====================================\n");
+}
+
+// ---------- SINGLE GAME ----------
+
+template <typename Dispatch>
+GameResult GameEngine::runGameWith(Dispatch &dispatch,
+                                   const string &mapFile,
+                                   const vector<string> &strategies,
+                                   int maxTurns,
+                                   uint64_t seed,
+                                   uint64_t stream,
+                                   GameRecorder *recorder)
+{
+    LOG_NOTIFY(EVENT, "Building Game engine. . .");
+    GameEngine game;
+    game.setSeed(seed, stream);
+    GameRngScope rngScope(game.rng); // map, cards and orders draw from this game's stream
+    game.buildGraph();
+    LOG_NOTIFY(EVENT, "GameEngine built!");
+
+    GameResult result;
+    if (!game.setupGame(mapFile, strategies))
+    {
+        result.winner = "Error";
+        return result;
+    }
+    dispatch.bind(game.players);
+    if (recorder)
+        recorder->begin(game, mapFile, seed, stream);
+    GameRecorderScope recorderScope(recorder);
+
+    // Main loop with turn limit
+    int turn = 1;
+    bool finished = false;
+    string winner = "Draw";
+    StalemateDetector stalemate(stalemateRule);
+    OutcomeForecaster forecaster(fastForwardRule);
+    int forecastEnd = 0;
+    // Extract strategy name (remove "_Player" suffix)
+    auto strategyOf = [](const Player *player)
+    {
+        string name = player->getPlayerName();
+        size_t pos = name.find("_Player");
+        return pos != string::npos ? name.substr(0, pos) : name;
+    };
+
+    while (!finished && turn <= maxTurns)
+    {
+        game.reinforcementPhase();
+        game.issueOrdersPhaseWith(dispatch);
+        game.executeOrdersPhaseWith(dispatch);
+
+        // Remove eliminated players
+        size_t slot = 0;
+        while (slot < game.players.size())
+        {
+            Player *player = game.players[slot];
+            if (player->getTerritories().empty())
+            {
+                LOG_NOTIFY(WARNING, player->getPlayerName(), " eliminated!");
+                if (recorder)
+                    recorder->playerEliminated(player);
+                delete player; // Delete the eliminated player
+                game.truces.removeSlot(static_cast<int>(slot));
+                game.players.erase(game.players.begin() + slot);
+                dispatch.removePlayer(slot);
+            }
+            else
+                ++slot;
+        }
+
+        LOG_MESSAGE(DEBUG, "Turn ", turn, ": ", game.players.size(), " players remaining");
+
+        // Win check - extract strategy name from player name
+        if (game.players.size() == 1)
+        {
+            winner = strategyOf(game.players[0]);
+            finished = true;
+        }
+        else if (game.players.empty())
+        {
+            winner = "Draw";
+            finished = true;
+        }
+        else if (turn < maxTurns && stalemate.endTurn(game, turn))
+        {
+            result.endReason = stalemate.getReason();
+            finished = true;
+        }
+        else if (fastForwardRule.enabled && turn < maxTurns)
+        {
+            Forecast forecast = forecaster.forecast(game, turn, maxTurns);
+            if (forecast.decided)
+            {
+                winner = forecast.winner ? strategyOf(forecast.winner) : "Draw";
+                result.forecast = true;
+                forecastEnd = forecast.endTurn;
+                result.confidence = forecast.confidence;
+                result.endReason = "fast-forwarded at turn " + to_string(turn) + " (" + forecast.basis +
+                                   ", confidence " + to_string(forecast.confidence).substr(0, 4) + ")";
+                finished = true;
+            }
+        }
+
+        turn++;
+    }
+
+    // Only set to draw if game wasn't finished (no winner determined)
+    if (!finished && turn > maxTurns)
+        winner = "Draw";
+    if (recorder)
+        recorder->finish(game.players.size() == 1 ? game.players[0] : nullptr);
+    result.winner = winner;
+    result.turns = turn - 1;
+    if (result.forecast)
+        result.turns = forecastEnd;
+
+    // Cleanup - delete remaining players manually
+    for (auto *p : game.players)
+        delete p;
+    game.players.clear();
+
+    // Delete map and deck, then set to nullptr to prevent double-delete in destructor
+    if (game.gameMap)
+    {
+        delete game.gameMap;
+        game.gameMap = nullptr;
+    }
+    if (game.gameDeck)
+    {
+        delete game.gameDeck;
+        game.gameDeck = nullptr;
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,950 @@
+#include "GameRecord.h"
+#include "GameEngine.h"
+#include "Map.h"
+#include "Player.h"
+#include "Orders.h"
+#include "Cards.h"
+#include "../PlayerStrategies/PlayerStrategies.h"
+#include "../utils/logger.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+const char RECORDING_MAGIC[4] = {'W', 'Z', 'R', 'P'};
+const char RECORDING_INDEX_MAGIC[4] = {'W', 'Z', 'R', 'X'};
+const uint32_t RECORDING_VERSION = 3; // 1: no keyframes, no index; 2: truces by player id
+const uint32_t RECORDING_MIN_VERSION = 3; // older files store truces by player id, which replay cannot map to slots
+const size_t RECORDING_FOOTER_SIZE = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(RECORDING_INDEX_MAGIC);
+const uint32_t RECORDING_MAX_COUNT = 1u << 26; // sanity limit on any stored length
+
+static thread_local GameRecorder *boundRecorder = nullptr;
+
+GameRecorder *activeRecorder()
+{
+    return boundRecorder;
+}
+
+GameRecorderScope::GameRecorderScope(GameRecorder *recorder) : previous(boundRecorder)
+{
+    boundRecorder = recorder;
+}
+
+GameRecorderScope::~GameRecorderScope()
+{
+    boundRecorder = previous;
+}
+
+int GameRecording::turnCount() const
+{
+    return static_cast<int>(count_if(events.begin(), events.end(), [](const ReplayEvent &event)
+                                     { return event.type == ReplayEventType::TurnEnd; }));
+}
+
+// ----------------- Recording -----------------
+
+// Two 16-bit ids (NO_PLAYER / NO_TERRITORY included) in one event field
+static int32_t packIds(int low, int high)
+{
+    return static_cast<int32_t>(static_cast<uint16_t>(low) | static_cast<uint32_t>(static_cast<uint16_t>(high)) << 16);
+}
+
+static int lowId(int32_t packed)
+{
+    return static_cast<int16_t>(static_cast<uint32_t>(packed) & 0xffffu);
+}
+
+static int highId(int32_t packed)
+{
+    return static_cast<int16_t>(static_cast<uint32_t>(packed) >> 16);
+}
+
+static vector<CardType> cardTypes(Span<Card *> cards)
+{
+    vector<CardType> types;
+    types.reserve(cards.size());
+    for (Card *card : cards)
+        types.push_back(card->getType());
+    return types;
+}
+
+void GameRecorder::begin(GameEngine &engine, const string &mapFile, uint64_t seed, uint64_t stream)
+{
+    game = &engine;
+    recording = GameRecording();
+    recording.mapFile = mapFile;
+    recording.seed = seed;
+    recording.stream = stream;
+    recording.start = engine.snapshot();
+    turn = 0;
+
+    slots.assign(engine.players.begin(), engine.players.end());
+    for (Player *player : engine.players)
+    {
+        recording.playerNames.push_back(player->getPlayerName());
+        recording.strategies.push_back(player->getPlayerStrategyName());
+    }
+    if (engine.neutralPlayer)
+        slots.push_back(engine.neutralPlayer);
+    seats.clear();
+    for (size_t slot = 0; slot < slots.size(); slot++)
+        seats.push_back(static_cast<int>(slot));
+
+    const GameSnapshot &start = recording.start;
+    armies = start.armies;
+    pools = start.reinforcementPool;
+    conquered = start.conqueredThisTurn;
+    hands.clear();
+    for (size_t slot = 0; slot < slots.size(); slot++)
+        hands.emplace_back(start.handCards.begin() + start.handOffsets[slot], start.handCards.begin() + start.handOffsets[slot + 1]);
+    deck = start.deck;
+    truces = start.truces;
+    pending.clear();
+    for (size_t slot = 0; slot < slots.size(); slot++)
+        pending.emplace_back(start.orders.begin() + start.orderOffsets[slot], start.orders.begin() + start.orderOffsets[slot + 1]);
+}
+
+// The state a replay reaches at this point, built from the live territories and the
+// (just synced) shadow copy, in recording slots
+GameSnapshot GameRecorder::keyframe()
+{
+    GameSnapshot snap;
+    int slotCount = static_cast<int>(slots.size());
+    snap.playerCount = slotCount;
+    snap.hasNeutral = slotCount > static_cast<int>(recording.playerNames.size());
+    snap.stateIndex = recording.start.stateIndex;
+    for (int id = 0; id < static_cast<int>(armies.size()); id++)
+        snap.owner.push_back(static_cast<int16_t>(slotOf(game->gameMap->getTerritoryById(id)->getOwner())));
+    snap.armies = armies;
+    snap.reinforcementPool = pools;
+    snap.conqueredThisTurn = conquered;
+    snap.territoryOffsets.push_back(0);
+    snap.handOffsets.push_back(0);
+    snap.orderOffsets.push_back(0);
+    for (int slot = 0; slot < slotCount; slot++)
+    {
+        if (slots[slot])
+        {
+            for (Territory *territory : slots[slot]->getTerritories())
+                snap.territoryIds.push_back(territory->getId());
+        }
+        snap.territoryOffsets.push_back(static_cast<int32_t>(snap.territoryIds.size()));
+        snap.handCards.insert(snap.handCards.end(), hands[slot].begin(), hands[slot].end());
+        snap.handOffsets.push_back(static_cast<int32_t>(snap.handCards.size()));
+        snap.orders.insert(snap.orders.end(), pending[slot].begin(), pending[slot].end());
+        snap.orderOffsets.push_back(static_cast<int32_t>(snap.orders.size()));
+    }
+    snap.deck = deck;
+    snap.truces = truces;
+    snap.rng = game->rng;
+    return snap;
+}
+
+int GameRecorder::slotOf(const Player *player)
+{
+    return slotAt(game->slotOf(player));
+}
+
+int GameRecorder::slotAt(int engineSlot)
+{
+    if (engineSlot == GameSnapshot::NO_PLAYER)
+        return GameSnapshot::NO_PLAYER;
+    if (engineSlot < static_cast<int>(seats.size()))
+        return seats[engineSlot];
+
+    // Only the neutral player joins after setup (first Blockade)
+    int slot = static_cast<int>(slots.size());
+    seats.push_back(slot);
+    slots.push_back(game->playerAtSlot(engineSlot));
+    pools.push_back(0);
+    conquered.push_back(0);
+    hands.emplace_back();
+    pending.emplace_back();
+    emit(ReplayEventType::NeutralJoined, slot);
+    return slot;
+}
+
+void GameRecorder::emit(ReplayEventType type, int player, int32_t a, int32_t b, int32_t c, uint8_t detail)
+{
+    recording.events.push_back({type, detail, static_cast<int16_t>(player), a, b, c});
+}
+
+void GameRecorder::ownerChanged(Territory *territory, Player *newOwner)
+{
+    Map *map = game ? game->gameMap : nullptr;
+    if (!map || !territory || territory != map->getTerritoryById(territory->getId()))
+        return; // a territory of some other game (simulation)
+    emit(ReplayEventType::OwnerChanged, slotOf(newOwner), territory->getId());
+}
+
+void GameRecorder::beforeOrder(Order *order)
+{
+    OrderParams params = order->params();
+    sourceArmiesBefore = params.source ? params.source->getArmies() : 0;
+    targetArmiesBefore = params.target ? params.target->getArmies() : 0;
+    targetOwnerBefore = params.target ? params.target->getOwner() : nullptr;
+}
+
+void GameRecorder::afterOrder(Order *order)
+{
+    OrderParams params = order->params();
+    int issuer = slotOf(params.issuer);
+    int source = params.source ? params.source->getId() : GameSnapshot::NO_TERRITORY;
+    int target = params.target ? params.target->getId() : GameSnapshot::NO_TERRITORY;
+    uint8_t detail = static_cast<uint8_t>(order->kind()) | (order->isExecuted() ? 0x80 : 0);
+    emit(ReplayEventType::OrderExecuted, issuer, source, target, params.armies, detail);
+
+    // An advance into someone else's territory that moved armies was a battle
+    if (order->kind() == OrderKind::Advance && params.source && params.target && targetOwnerBefore != params.issuer)
+    {
+        int attackers = sourceArmiesBefore - params.source->getArmies();
+        if (attackers > 0)
+        {
+            bool conquered = params.target->getOwner() == params.issuer;
+            emit(ReplayEventType::Combat, issuer, target, attackers, targetArmiesBefore, conquered ? 1 : 0);
+        }
+    }
+    sync();
+}
+
+// Turns old into current with removals at one spot plus appends at the end, which
+// covers a card drawn (removed anywhere, appended to a hand) and a card played
+void GameRecorder::diffCards(int player, vector<CardType> &shadow, const vector<CardType> &current)
+{
+    if (shadow == current)
+        return;
+    size_t prefix = 0;
+    while (prefix < shadow.size() && prefix < current.size() && shadow[prefix] == current[prefix])
+        prefix++;
+    size_t suffix = 0;
+    while (suffix < shadow.size() - prefix && suffix < current.size() - prefix &&
+           shadow[shadow.size() - 1 - suffix] == current[current.size() - 1 - suffix])
+        suffix++;
+
+    if (prefix + suffix == current.size())
+    {
+        for (size_t i = prefix + suffix; i < shadow.size(); i++)
+            emit(ReplayEventType::CardRemoved, player, static_cast<int32_t>(prefix));
+    }
+    else
+    {
+        emit(ReplayEventType::CardsTruncated, player, static_cast<int32_t>(prefix));
+        for (size_t i = prefix; i < current.size(); i++)
+            emit(ReplayEventType::CardAppended, player, 0, 0, 0, static_cast<uint8_t>(current[i]));
+    }
+    shadow = current;
+}
+
+vector<GameSnapshot::PendingOrder> GameRecorder::pendingOrders(Player *player)
+{
+    vector<GameSnapshot::PendingOrder> orders;
+    OrderContext context(*game);
+    auto add = [&](const Order *pending)
+    {
+        CompactOrder order = context.compact(*pending);
+        order.issuer = static_cast<int16_t>(slotAt(order.issuer)); // engine slots to recording slots
+        order.other = static_cast<int16_t>(slotAt(order.other));
+        orders.push_back(order);
+    };
+    orders.reserve(player->getOrdersList()->size());
+    player->getOrdersList()->forEachInOrder(add);
+    return orders;
+}
+
+void GameRecorder::sync()
+{
+    Map *map = game->gameMap;
+    int territoryCount = map ? map->getTerritoriesSize() : 0;
+    for (int id = 0; id < territoryCount; id++)
+    {
+        int current = map->getTerritoryById(id)->getArmies();
+        if (armies[id] != current)
+        {
+            armies[id] = current;
+            emit(ReplayEventType::ArmiesSet, GameSnapshot::NO_PLAYER, id, current);
+        }
+    }
+
+    for (size_t slot = 0; slot < slots.size(); slot++)
+    {
+        Player *player = slots[slot];
+        if (!player)
+            continue;
+        int s = static_cast<int>(slot);
+        if (pools[slot] != player->getReinforcementPool())
+        {
+            pools[slot] = player->getReinforcementPool();
+            emit(ReplayEventType::PoolSet, s, pools[slot]);
+        }
+        uint8_t flag = player->hasConqueredThisTurn() ? 1 : 0;
+        if (conquered[slot] != flag)
+        {
+            conquered[slot] = flag;
+            emit(ReplayEventType::ConqueredFlag, s, flag);
+        }
+        diffCards(s, hands[slot], cardTypes(player->getHandOfCards()->getCards()));
+    }
+    if (game->gameDeck)
+        diffCards(GameSnapshot::NO_PLAYER, deck, cardTypes(game->gameDeck->getCards()));
+
+    // The engine's slots shift when a player is eliminated; recording slots do not
+    vector<pair<int, int>> current;
+    for (const pair<int, int> &truce : game->truces.pairs())
+    {
+        int a = slotAt(truce.first), b = slotAt(truce.second);
+        current.push_back({min(a, b), max(a, b)});
+    }
+    sort(current.begin(), current.end());
+    if (current != truces)
+    {
+        emit(ReplayEventType::TrucesCleared, GameSnapshot::NO_PLAYER);
+        for (const pair<int, int> &truce : current)
+            emit(ReplayEventType::TruceAdded, GameSnapshot::NO_PLAYER, truce.first, truce.second);
+        truces = current;
+    }
+}
+
+void GameRecorder::endTurn()
+{
+    sync();
+    // Orders of a player who lost every territory mid-turn stay queued
+    for (size_t slot = 0; slot < slots.size(); slot++)
+    {
+        if (!slots[slot])
+            continue;
+        vector<GameSnapshot::PendingOrder> current = pendingOrders(slots[slot]);
+        if (current == pending[slot])
+            continue;
+        int s = static_cast<int>(slot);
+        emit(ReplayEventType::OrdersCleared, s);
+        for (const GameSnapshot::PendingOrder &order : current)
+            emit(ReplayEventType::OrderPending, s, packIds(order.source, order.target), order.armies,
+                 packIds(order.issuer, order.other), static_cast<uint8_t>(order.kind));
+        pending[slot] = move(current);
+    }
+    turn++;
+    for (int word = 0; word < 4; word++)
+    {
+        uint64_t value = game->rng.stateWord(word);
+        emit(ReplayEventType::RngWord, GameSnapshot::NO_PLAYER, static_cast<int32_t>(value & 0xffffffffu),
+             static_cast<int32_t>(value >> 32), 0, static_cast<uint8_t>(word));
+    }
+    emit(ReplayEventType::TurnEnd, GameSnapshot::NO_PLAYER, turn);
+
+    if (keyframeInterval > 0 && turn % keyframeInterval == 0)
+        recording.keyframes.push_back({turn, static_cast<uint32_t>(recording.events.size()), keyframe()});
+}
+
+void GameRecorder::playerEliminated(Player *player)
+{
+    int engineSlot = game->slotOf(player);
+    int slot = slotAt(engineSlot);
+    emit(ReplayEventType::PlayerEliminated, slot);
+    pending[slot].clear();
+    slots[slot] = nullptr; // the player object is about to be deleted
+    seats.erase(seats.begin() + engineSlot);
+}
+
+void GameRecorder::finish(Player *winner)
+{
+    emit(ReplayEventType::GameEnd, slotOf(winner), turn);
+    LOG_NOTIFY(REPLAY, "Recorded ", recording.mapFile, " stream ", recording.stream, ": ", turn, " turns, ",
+               recording.events.size(), " events (", recording.events.size() * sizeof(ReplayEvent), " bytes)");
+}
+
+// ----------------- File format -----------------
+
+template <typename T>
+static void writeValue(ostream &out, const T &value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T>
+static bool readValue(istream &in, T &value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+static void writeString(ostream &out, const string &text)
+{
+    writeValue(out, static_cast<uint32_t>(text.size()));
+    out.write(text.data(), text.size());
+}
+
+static bool readString(istream &in, string &text)
+{
+    uint32_t size;
+    if (!readValue(in, size) || size > RECORDING_MAX_COUNT)
+        return false;
+    text.resize(size);
+    return static_cast<bool>(in.read(&text[0], size));
+}
+
+// Plain arrays of integers (or enums stored as integers) are written raw
+template <typename T>
+static void writeArray(ostream &out, const vector<T> &values)
+{
+    writeValue(out, static_cast<uint32_t>(values.size()));
+    out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+static bool readArray(istream &in, vector<T> &values)
+{
+    uint32_t size;
+    if (!readValue(in, size) || size > RECORDING_MAX_COUNT)
+        return false;
+    values.resize(size);
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(values.data()), size * sizeof(T)));
+}
+
+static void writeSnapshot(ostream &out, const GameSnapshot &snap)
+{
+    writeValue(out, static_cast<int32_t>(snap.playerCount));
+    writeValue(out, static_cast<uint8_t>(snap.hasNeutral));
+    writeValue(out, static_cast<int32_t>(snap.stateIndex));
+    writeArray(out, snap.owner);
+    writeArray(out, snap.armies);
+    writeArray(out, snap.reinforcementPool);
+    writeArray(out, snap.conqueredThisTurn);
+    writeArray(out, snap.territoryOffsets);
+    writeArray(out, snap.territoryIds);
+    writeArray(out, snap.handOffsets);
+    writeArray(out, snap.handCards);
+    writeArray(out, snap.orderOffsets);
+    writeValue(out, static_cast<uint32_t>(snap.orders.size()));
+    for (const GameSnapshot::PendingOrder &order : snap.orders)
+    {
+        writeValue(out, static_cast<int32_t>(order.kind));
+        writeValue(out, order.issuer);
+        writeValue(out, order.other);
+        writeValue(out, order.source);
+        writeValue(out, order.target);
+        writeValue(out, order.armies);
+    }
+    writeArray(out, snap.deck);
+    writeValue(out, static_cast<uint32_t>(snap.truces.size()));
+    for (const pair<int, int> &truce : snap.truces)
+    {
+        writeValue(out, static_cast<int32_t>(truce.first));
+        writeValue(out, static_cast<int32_t>(truce.second));
+    }
+    writeValue(out, snap.rng.getSeed());
+    writeValue(out, snap.rng.getStream());
+    for (int word = 0; word < 4; word++)
+        writeValue(out, snap.rng.stateWord(word));
+}
+
+static bool readSnapshot(istream &in, GameSnapshot &snap)
+{
+    int32_t playerCount, stateIndex;
+    uint8_t hasNeutral;
+    uint32_t count;
+    if (!readValue(in, playerCount) || !readValue(in, hasNeutral) || !readValue(in, stateIndex))
+        return false;
+    snap.playerCount = playerCount;
+    snap.hasNeutral = hasNeutral != 0;
+    snap.stateIndex = stateIndex;
+    if (!readArray(in, snap.owner) || !readArray(in, snap.armies) || !readArray(in, snap.reinforcementPool) ||
+        !readArray(in, snap.conqueredThisTurn) || !readArray(in, snap.territoryOffsets) ||
+        !readArray(in, snap.territoryIds) || !readArray(in, snap.handOffsets) || !readArray(in, snap.handCards) ||
+        !readArray(in, snap.orderOffsets) || !readValue(in, count) || count > RECORDING_MAX_COUNT)
+        return false;
+    snap.orders.resize(count);
+    for (GameSnapshot::PendingOrder &order : snap.orders)
+    {
+        int32_t kind;
+        if (!readValue(in, kind) || !readValue(in, order.issuer) || !readValue(in, order.other) ||
+            !readValue(in, order.source) || !readValue(in, order.target) || !readValue(in, order.armies))
+            return false;
+        order.kind = static_cast<OrderKind>(kind);
+    }
+    if (!readArray(in, snap.deck) || !readValue(in, count) || count > RECORDING_MAX_COUNT)
+        return false;
+    snap.truces.resize(count);
+    for (pair<int, int> &truce : snap.truces)
+    {
+        int32_t first, second;
+        if (!readValue(in, first) || !readValue(in, second))
+            return false;
+        truce = {first, second};
+    }
+    uint64_t seed, stream, words[4];
+    if (!readValue(in, seed) || !readValue(in, stream))
+        return false;
+    snap.rng.reseed(seed, stream);
+    for (int word = 0; word < 4; word++)
+    {
+        if (!readValue(in, words[word]))
+            return false;
+        snap.rng.setStateWord(word, words[word]);
+    }
+    // Replay builds iterators from the offsets and indexes by the ids, so a damaged
+    // snapshot stops here; the territory count is checked against the map on replay
+    return snap.wellFormed(static_cast<int>(snap.owner.size()));
+}
+
+RecordingWriter::RecordingWriter(const string &path) : out(path, ios::binary | ios::trunc)
+{
+    open = out.is_open();
+    if (!open)
+    {
+        logMessage(ERROR, "Cannot write recording: " + path);
+        return;
+    }
+    out.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    writeValue(out, RECORDING_VERSION);
+    out.flush();
+}
+
+RecordingWriter::~RecordingWriter()
+{
+    close();
+}
+
+bool RecordingWriter::write(const GameRecording &recording)
+{
+    lock_guard<mutex> guard(lock);
+    if (!open)
+        return false;
+    IndexEntry entry;
+    entry.block = static_cast<uint64_t>(out.tellp());
+    writeValue(out, recording.seed);
+    writeValue(out, recording.stream);
+    writeString(out, recording.mapFile);
+    writeValue(out, static_cast<uint32_t>(recording.playerNames.size()));
+    for (size_t i = 0; i < recording.playerNames.size(); i++)
+    {
+        writeString(out, recording.playerNames[i]);
+        writeString(out, recording.strategies[i]);
+    }
+    writeSnapshot(out, recording.start);
+    writeValue(out, static_cast<uint32_t>(recording.keyframes.size()));
+    for (const ReplayKeyframe &keyframe : recording.keyframes)
+    {
+        entry.keyframes.push_back({keyframe.turn, static_cast<uint64_t>(out.tellp())});
+        writeValue(out, keyframe.turn);
+        writeValue(out, keyframe.event);
+        writeSnapshot(out, keyframe.state);
+    }
+    entry.events = static_cast<uint64_t>(out.tellp());
+    writeArray(out, recording.events);
+    out.flush();
+    index.push_back(move(entry));
+    return out.good();
+}
+
+void RecordingWriter::close()
+{
+    lock_guard<mutex> guard(lock);
+    if (!open)
+        return;
+    uint64_t indexOffset = static_cast<uint64_t>(out.tellp());
+    for (const IndexEntry &entry : index)
+    {
+        writeValue(out, entry.block);
+        writeValue(out, entry.events);
+        writeValue(out, static_cast<uint32_t>(entry.keyframes.size()));
+        for (const pair<int32_t, uint64_t> &keyframe : entry.keyframes)
+        {
+            writeValue(out, keyframe.first);
+            writeValue(out, keyframe.second);
+        }
+    }
+    writeValue(out, indexOffset);
+    writeValue(out, static_cast<uint32_t>(index.size()));
+    out.write(RECORDING_INDEX_MAGIC, sizeof(RECORDING_INDEX_MAGIC));
+    out.close();
+    open = false;
+}
+
+static bool readHeader(istream &in)
+{
+    char magic[4];
+    uint32_t version;
+    return in.read(magic, sizeof(magic)) && memcmp(magic, RECORDING_MAGIC, sizeof(magic)) == 0 &&
+           readValue(in, version) && version >= RECORDING_MIN_VERSION && version <= RECORDING_VERSION;
+}
+
+// Offset of the index, or 0 if the file has none (its writer never closed)
+static uint64_t readFooter(istream &in, uint32_t &games)
+{
+    char magic[4];
+    uint64_t indexOffset;
+    in.seekg(0, ios::end);
+    uint64_t size = static_cast<uint64_t>(in.tellg());
+    in.seekg(size >= RECORDING_FOOTER_SIZE ? size - RECORDING_FOOTER_SIZE : 0);
+    bool ok = size >= RECORDING_FOOTER_SIZE && readValue(in, indexOffset) && readValue(in, games) &&
+              in.read(magic, sizeof(magic)) && memcmp(magic, RECORDING_INDEX_MAGIC, sizeof(magic)) == 0 &&
+              indexOffset < size;
+    in.clear();
+    return ok ? indexOffset : 0;
+}
+
+// Game block up to its keyframes: seed, stream, map, players, start snapshot
+static bool readGameStart(istream &in, GameRecording &recording)
+{
+    uint32_t players;
+    bool ok = readValue(in, recording.seed) && readValue(in, recording.stream) &&
+              readString(in, recording.mapFile) && readValue(in, players) && players <= RECORDING_MAX_COUNT;
+    for (uint32_t i = 0; ok && i < players; i++)
+    {
+        string name, strategy;
+        ok = readString(in, name) && readString(in, strategy);
+        recording.playerNames.push_back(name);
+        recording.strategies.push_back(strategy);
+    }
+    return ok && readSnapshot(in, recording.start);
+}
+
+static bool readKeyframe(istream &in, ReplayKeyframe &keyframe)
+{
+    return readValue(in, keyframe.turn) && readValue(in, keyframe.event) && readSnapshot(in, keyframe.state);
+}
+
+bool readRecordings(const string &path, vector<GameRecording> &recordings)
+{
+    ifstream in(path, ios::binary);
+    uint32_t games;
+    if (!readHeader(in))
+    {
+        logMessage(ERROR, "Not a game recording, or one from an older version: " + path);
+        return false;
+    }
+    uint64_t blocksStart = static_cast<uint64_t>(in.tellg());
+    uint64_t blocksEnd = readFooter(in, games);
+    if (blocksEnd == 0)
+    {
+        in.seekg(0, ios::end);
+        blocksEnd = static_cast<uint64_t>(in.tellg());
+    }
+    in.seekg(blocksStart);
+
+    while (static_cast<uint64_t>(in.tellg()) < blocksEnd)
+    {
+        GameRecording recording;
+        uint32_t keyframes = 0;
+        bool ok = readGameStart(in, recording) && readValue(in, keyframes) && keyframes <= RECORDING_MAX_COUNT;
+        recording.keyframes.resize(keyframes);
+        for (uint32_t i = 0; ok && i < keyframes; i++)
+            ok = readKeyframe(in, recording.keyframes[i]);
+        ok = ok && readArray(in, recording.events);
+        if (!ok)
+        {
+            logMessage(ERROR, "Truncated game recording: " + path);
+            return false;
+        }
+        recordings.push_back(move(recording));
+    }
+    return true;
+}
+
+bool RecordingFile::open(const string &path)
+{
+    games.clear();
+    in.close();
+    in.clear();
+    in.open(path, ios::binary);
+    uint32_t count;
+    uint64_t indexOffset = 0;
+    if (readHeader(in))
+        indexOffset = readFooter(in, count);
+    if (indexOffset == 0 || count > RECORDING_MAX_COUNT)
+    {
+        logMessage(ERROR, "No readable recording index: " + path);
+        return false;
+    }
+
+    in.seekg(indexOffset);
+    games.resize(count);
+    for (GameEntry &entry : games)
+    {
+        uint32_t keyframes;
+        if (!readValue(in, entry.block) || !readValue(in, entry.events) || !readValue(in, keyframes) ||
+            keyframes > RECORDING_MAX_COUNT)
+        {
+            games.clear();
+            logMessage(ERROR, "Truncated recording index: " + path);
+            return false;
+        }
+        entry.keyframes.resize(keyframes);
+        for (pair<int32_t, uint64_t> &keyframe : entry.keyframes)
+        {
+            if (!readValue(in, keyframe.first) || !readValue(in, keyframe.second))
+            {
+                games.clear();
+                logMessage(ERROR, "Truncated recording index: " + path);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool RecordingFile::load(int game, int fromTurn, GameRecording &recording)
+{
+    if (game < 0 || game >= gameCount())
+        return false;
+    const GameEntry &entry = games[game];
+    recording = GameRecording();
+    in.clear();
+    in.seekg(entry.block);
+    if (!readGameStart(in, recording))
+        return false;
+
+    // Latest keyframe at or before fromTurn (keyframes are in turn order)
+    uint32_t firstEvent = 0;
+    for (auto it = entry.keyframes.rbegin(); it != entry.keyframes.rend(); ++it)
+    {
+        if (it->first > fromTurn)
+            continue;
+        ReplayKeyframe keyframe;
+        in.seekg(it->second);
+        if (!readKeyframe(in, keyframe))
+            return false;
+        recording.start = move(keyframe.state);
+        recording.startTurn = keyframe.turn;
+        firstEvent = keyframe.event;
+        break;
+    }
+
+    uint32_t events;
+    in.seekg(entry.events);
+    if (!readValue(in, events) || events > RECORDING_MAX_COUNT || firstEvent > events)
+        return false;
+    in.seekg(entry.events + sizeof(uint32_t) + firstEvent * sizeof(ReplayEvent));
+    recording.events.resize(events - firstEvent);
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(recording.events.data()),
+                                     recording.events.size() * sizeof(ReplayEvent)));
+}
+
+// ----------------- Replay -----------------
+
+ReplayEngine::ReplayEngine(const GameRecording &recording) : recording(recording)
+{
+    engine = new GameEngine();
+    engine->buildGraph();
+    engine->rng = recording.start.rng;
+    GameRngScope rngScope(engine->rng);
+
+    MapLoader loader;
+    if (recording.playerNames.size() <= static_cast<size_t>(GameEngine::MAX_PLAYERS))
+        engine->gameMap = loader.loadMap(recording.mapFile);
+    if (engine->gameMap)
+    {
+        for (size_t i = 0; i < recording.playerNames.size(); i++)
+        {
+            Player *player = new Player(recording.playerNames[i]);
+            player->setStrategy(createStrategy(recording.strategies[i], engine));
+            engine->players.push_back(player);
+        }
+        engine->gameDeck = new Deck();
+    }
+    // restore checks the start; keyframes are loaded without it, so check them here
+    bool fits = engine->gameMap != nullptr;
+    for (size_t i = 0; fits && i < recording.keyframes.size(); i++)
+        fits = recording.keyframes[i].state.wellFormed(engine->gameMap->getTerritoriesSize());
+    if (!fits || !engine->restore(recording.start))
+    {
+        LOG_NOTIFY(ERROR, "Cannot rebuild recorded game on ", recording.mapFile);
+        delete engine;
+        engine = nullptr;
+        return;
+    }
+    loadState(recording.start, recording.startTurn, 0);
+}
+
+ReplayEngine::~ReplayEngine()
+{
+    delete engine;
+}
+
+void ReplayEngine::loadState(const GameSnapshot &start, int atTurn, size_t atEvent)
+{
+    state = State();
+    state.owner = start.owner;
+    state.armies = start.armies;
+    state.listSlot.assign(start.owner.size(), -1);
+    state.pools = start.reinforcementPool;
+    state.conquered = start.conqueredThisTurn;
+    for (int slot = 0; slot < start.playerCount; slot++)
+    {
+        state.territories.emplace_back(start.territoryIds.begin() + start.territoryOffsets[slot],
+                                       start.territoryIds.begin() + start.territoryOffsets[slot + 1]);
+        for (size_t i = 0; i < state.territories[slot].size(); i++)
+            state.listSlot[state.territories[slot][i]] = static_cast<int32_t>(i);
+        state.hands.emplace_back(start.handCards.begin() + start.handOffsets[slot],
+                                 start.handCards.begin() + start.handOffsets[slot + 1]);
+        state.orders.emplace_back(start.orders.begin() + start.orderOffsets[slot],
+                                  start.orders.begin() + start.orderOffsets[slot + 1]);
+    }
+    state.deck = start.deck;
+    state.truces = start.truces;
+    state.rng = start.rng;
+    cursor = atEvent;
+    turn = atTurn;
+}
+
+void ReplayEngine::growTo(int slot)
+{
+    if (slot < static_cast<int>(state.territories.size()))
+        return;
+    state.territories.resize(slot + 1);
+    state.pools.resize(slot + 1, 0);
+    state.conquered.resize(slot + 1, 0);
+    state.hands.resize(slot + 1);
+    state.orders.resize(slot + 1);
+}
+
+// Events come from this build's recorder, but a damaged file must not index out of range
+void ReplayEngine::apply(const ReplayEvent &event)
+{
+    int territoryCount = static_cast<int>(state.owner.size());
+    bool validTerritory = event.a >= 0 && event.a < territoryCount;
+    if (event.player >= 0)
+        growTo(event.player);
+    vector<CardType> *cards = event.player >= 0 ? &state.hands[event.player] : &state.deck;
+
+    switch (event.type)
+    {
+    case ReplayEventType::OwnerChanged:
+    {
+        if (!validTerritory)
+            break;
+        // Same list operations as Player::transferTerritory: swap-remove, then append
+        int id = event.a;
+        int oldOwner = state.owner[id];
+        if (oldOwner == event.player)
+            break;
+        if (oldOwner >= 0)
+        {
+            vector<int32_t> &list = state.territories[oldOwner];
+            int slot = state.listSlot[id];
+            if (slot >= 0 && slot < static_cast<int>(list.size()) && list[slot] == id)
+            {
+                list[slot] = list.back();
+                state.listSlot[list[slot]] = slot;
+                list.pop_back();
+            }
+        }
+        state.listSlot[id] = -1;
+        if (event.player >= 0)
+        {
+            state.listSlot[id] = static_cast<int32_t>(state.territories[event.player].size());
+            state.territories[event.player].push_back(id);
+        }
+        state.owner[id] = event.player;
+        break;
+    }
+    case ReplayEventType::ArmiesSet:
+        if (validTerritory)
+            state.armies[event.a] = event.b;
+        break;
+    case ReplayEventType::PoolSet:
+        if (event.player >= 0)
+            state.pools[event.player] = event.a;
+        break;
+    case ReplayEventType::ConqueredFlag:
+        if (event.player >= 0)
+            state.conquered[event.player] = static_cast<uint8_t>(event.a);
+        break;
+    case ReplayEventType::CardRemoved:
+        if (event.a >= 0 && event.a < static_cast<int>(cards->size()))
+            cards->erase(cards->begin() + event.a);
+        break;
+    case ReplayEventType::CardsTruncated:
+        if (event.a >= 0 && event.a <= static_cast<int>(cards->size()))
+            cards->resize(event.a);
+        break;
+    case ReplayEventType::CardAppended:
+        cards->push_back(static_cast<CardType>(event.detail));
+        break;
+    case ReplayEventType::TrucesCleared:
+        state.truces.clear();
+        break;
+    case ReplayEventType::TruceAdded:
+        state.truces.push_back({event.a, event.b});
+        break;
+    case ReplayEventType::OrdersCleared:
+    case ReplayEventType::PlayerEliminated:
+        if (event.player >= 0)
+            state.orders[event.player].clear();
+        break;
+    case ReplayEventType::OrderPending:
+        if (event.player >= 0)
+            state.orders[event.player].push_back({static_cast<OrderKind>(event.detail), static_cast<int16_t>(lowId(event.c)),
+                                                  static_cast<int16_t>(highId(event.c)), lowId(event.a), highId(event.a), event.b});
+        break;
+    case ReplayEventType::RngWord:
+        if (event.detail < 4)
+            state.rng.setStateWord(event.detail, static_cast<uint32_t>(event.a) | static_cast<uint64_t>(static_cast<uint32_t>(event.b)) << 32);
+        break;
+    case ReplayEventType::TurnEnd:
+        turn = event.a;
+        break;
+    default: // orders and battles: the state changes they caused have their own events
+        break;
+    }
+}
+
+GameSnapshot ReplayEngine::toSnapshot() const
+{
+    const GameSnapshot &start = recording.start;
+    GameSnapshot snap;
+    int slots = static_cast<int>(state.territories.size());
+    snap.playerCount = slots;
+    snap.hasNeutral = slots > static_cast<int>(recording.playerNames.size());
+    snap.stateIndex = start.stateIndex;
+    snap.owner = state.owner;
+    snap.armies = state.armies;
+    snap.reinforcementPool = state.pools;
+    snap.conqueredThisTurn = state.conquered;
+    snap.territoryOffsets.push_back(0);
+    snap.handOffsets.push_back(0);
+    snap.orderOffsets.push_back(0);
+    for (int slot = 0; slot < slots; slot++)
+    {
+        snap.territoryIds.insert(snap.territoryIds.end(), state.territories[slot].begin(), state.territories[slot].end());
+        snap.territoryOffsets.push_back(static_cast<int32_t>(snap.territoryIds.size()));
+        snap.handCards.insert(snap.handCards.end(), state.hands[slot].begin(), state.hands[slot].end());
+        snap.handOffsets.push_back(static_cast<int32_t>(snap.handCards.size()));
+        snap.orders.insert(snap.orders.end(), state.orders[slot].begin(), state.orders[slot].end());
+        snap.orderOffsets.push_back(static_cast<int32_t>(snap.orders.size()));
+    }
+    snap.deck = state.deck;
+    snap.truces = state.truces;
+    snap.rng = state.rng;
+    return snap;
+}
+
+bool ReplayEngine::seekTurn(int target)
+{
+    if (!engine)
+        return false;
+    if (target < recording.startTurn)
+        return false;
+
+    // Start over from the nearest keyframe (or the start) unless the current position is closer
+    const ReplayKeyframe *nearest = nullptr;
+    for (const ReplayKeyframe &keyframe : recording.keyframes)
+    {
+        if (keyframe.turn <= target && keyframe.turn >= recording.startTurn)
+            nearest = &keyframe;
+    }
+    int from = nearest ? nearest->turn : recording.startTurn;
+    if (target < turn || from > turn)
+    {
+        if (nearest)
+            loadState(nearest->state, nearest->turn, nearest->event);
+        else
+            loadState(recording.start, recording.startTurn, 0);
+    }
+    while (turn < target && cursor < recording.events.size())
+        apply(recording.events[cursor++]);
+
+    if (!engine->restore(toSnapshot()))
+        return false;
+    LOG_NOTIFY(REPLAY, "Replay of ", recording.mapFile, " stream ", recording.stream, " at turn ", turn);
+    return turn == target;
+}
@@ -0,0 +1,263 @@
+#ifndef GAME_RECORD_H
+#define GAME_RECORD_H
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "GameSnapshot.h"
+#include "../utils/LoggingObserver.h"
+
+class GameEngine;
+class Player;
+class Territory;
+class Order;
+
+// Binary game recordings: the state of a game right after setup, then every change as
+// a fixed-size event. A ReplayEngine applies the events to that state to rebuild the
+// game at any turn without running a strategy or a battle.
+//
+// Long games also carry keyframes: full snapshots every few turns, so a seek starts from
+// the nearest one and applies only the events after it.
+//
+// File layout (little-endian, as written by the host): "WZRP", uint32 version, then one
+// block per game: seed, stream, map path, strategy names, start snapshot, keyframes,
+// events. The index follows the last block: per game its block offset and the turn and
+// offset of each keyframe, then uint64 index offset, uint32 game count and "WZRX".
+
+enum class ReplayEventType : uint8_t
+{
+    TurnEnd,          // a = turn; the state is complete at this point
+    OrderExecuted,    // detail = OrderKind (bit 7: took effect), player = issuer, a = source, b = target, c = armies
+    Combat,           // player = attacker, a = target, b = attackers, c = defenders, detail = 1 if conquered
+    OwnerChanged,     // a = territory, player = new owner
+    ArmiesSet,        // a = territory, b = armies
+    PoolSet,          // player, a = reinforcement pool
+    ConqueredFlag,    // player, a = 0 / 1
+    CardRemoved,      // player (NO_PLAYER = deck), a = index
+    CardsTruncated,   // player (NO_PLAYER = deck), a = new size
+    CardAppended,     // player (NO_PLAYER = deck), detail = CardType
+    TrucesCleared,    // every truce ends (start of execution)
+    TruceAdded,       // a, b = player slots
+    OrdersCleared,    // player; then one OrderPending per order still queued at the end of the turn
+    OrderPending,     // player, detail = OrderKind, a = source | target << 16, b = armies, c = issuer | other << 16 (16-bit ids)
+    RngWord,          // detail = word index, a = low half, b = high half
+    NeutralJoined,    // player = slot the neutral player takes
+    PlayerEliminated, // player
+    GameEnd           // a = turns played, player = winner slot or NO_PLAYER
+};
+
+// One change: 16 bytes, no pointers
+struct ReplayEvent
+{
+    ReplayEventType type;
+    uint8_t detail;
+    int16_t player; // recording slot: the players at setup, then the neutral player
+    int32_t a;
+    int32_t b;
+    int32_t c;
+};
+static_assert(sizeof(ReplayEvent) == 16, "replay events are written as raw 16-byte records");
+
+// Full state at the end of a turn, players in recording slots (eliminated ones empty)
+struct ReplayKeyframe
+{
+    int32_t turn = 0;
+    uint32_t event = 0; // index of the first event after the keyframe
+    GameSnapshot state;
+};
+
+// Everything needed to rebuild one game
+struct GameRecording
+{
+    std::string mapFile;
+    std::vector<std::string> playerNames; // in slot order (after setup's shuffle), neutral excluded
+    std::vector<std::string> strategies;
+    uint64_t seed = 0;
+    uint64_t stream = 0;
+    GameSnapshot start;
+    int startTurn = 0; // turn start was taken at: 0, or a keyframe's when loaded from one
+    std::vector<ReplayKeyframe> keyframes;
+    std::vector<ReplayEvent> events;
+
+    int turnCount() const; // TurnEnd events recorded
+};
+
+// Records one game. While a GameRecorderScope binds it to the game's thread, the engine
+// phases and Player::transferTerritory report to it; it diffs the rest against a shadow
+// copy after every order and phase, so the event stream holds only real changes.
+class GameRecorder : public Subject, public ILoggable
+{
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_ENGINE; }
+    GameRecorder() = default;
+    GameRecorder(const GameRecorder &) = delete;
+    GameRecorder &operator=(const GameRecorder &) = delete;
+
+    void begin(GameEngine &engine, const std::string &mapFile, uint64_t seed, uint64_t stream);
+    void setKeyframeInterval(int turns) { keyframeInterval = turns; } // 0 = no keyframes
+    bool records(const GameEngine *engine) const { return engine == game; }
+
+    // Hooks (GameEngine phases, Player::transferTerritory)
+    void ownerChanged(Territory *territory, Player *newOwner);
+    void beforeOrder(Order *order);
+    void afterOrder(Order *order);
+    void sync(); // diff armies, pools, flags, cards and truces against the shadow copy
+    void endTurn();
+    void playerEliminated(Player *player);
+    void finish(Player *winner);
+
+    const GameRecording &getRecording() const { return recording; }
+
+private:
+    int slotOf(const Player *player);
+    int slotAt(int engineSlot); // recording slot of an engine slot
+    void emit(ReplayEventType type, int player, int32_t a = 0, int32_t b = 0, int32_t c = 0, uint8_t detail = 0);
+    void diffCards(int player, std::vector<CardType> &shadow, const std::vector<CardType> &current);
+    std::vector<GameSnapshot::PendingOrder> pendingOrders(Player *player);
+    GameSnapshot keyframe();
+
+    GameEngine *game = nullptr;
+    GameRecording recording;
+    std::vector<Player *> slots; // by recording slot, nullptr once eliminated
+    std::vector<int> seats;      // recording slot of each engine slot (these shift on elimination)
+    int turn = 0;
+    int keyframeInterval = 32;
+
+    // Shadow state, as of the last event
+    std::vector<int32_t> armies;
+    std::vector<int32_t> pools;
+    std::vector<uint8_t> conquered;
+    std::vector<std::vector<CardType>> hands;
+    std::vector<CardType> deck;
+    std::vector<std::pair<int, int>> truces;
+    std::vector<std::vector<GameSnapshot::PendingOrder>> pending; // as of the last turn end
+
+    // Order in flight (beforeOrder -> afterOrder)
+    int sourceArmiesBefore = 0;
+    int targetArmiesBefore = 0;
+    Player *targetOwnerBefore = nullptr;
+};
+
+// Recorder of the game running on this thread, or nullptr
+GameRecorder *activeRecorder();
+// Same, but only if it records engine (simulations on the same thread are ignored)
+inline GameRecorder *activeRecorderFor(const GameEngine *engine)
+{
+    GameRecorder *recorder = activeRecorder();
+    return recorder && recorder->records(engine) ? recorder : nullptr;
+}
+
+// Binds a recorder to the current thread until the scope ends (scopes nest)
+class GameRecorderScope
+{
+public:
+    explicit GameRecorderScope(GameRecorder *recorder);
+    ~GameRecorderScope();
+
+    GameRecorderScope(const GameRecorderScope &) = delete;
+    GameRecorderScope &operator=(const GameRecorderScope &) = delete;
+
+private:
+    GameRecorder *previous;
+};
+
+// Appends finished games to a recording file; safe to share between tournament threads.
+// The index is written when the writer is closed or destroyed.
+class RecordingWriter
+{
+public:
+    explicit RecordingWriter(const std::string &path);
+    ~RecordingWriter();
+    bool isOpen() const { return open; }
+    bool write(const GameRecording &recording);
+    void close();
+
+private:
+    struct IndexEntry
+    {
+        uint64_t block;
+        uint64_t events;
+        std::vector<std::pair<int32_t, uint64_t>> keyframes; // turn, offset of its record
+    };
+
+    std::ofstream out;
+    bool open = false;
+    std::vector<IndexEntry> index;
+    std::mutex lock;
+};
+
+// Reads every game (a file whose writer never closed has no index but is still read)
+bool readRecordings(const std::string &path, std::vector<GameRecording> &recordings);
+
+// Random access through the index: a game is loaded from the keyframe nearest a turn,
+// reading only that keyframe and the events after it
+class RecordingFile
+{
+public:
+    bool open(const std::string &path); // false if the file or its index is unreadable
+    int gameCount() const { return static_cast<int>(games.size()); }
+    bool load(int game, int fromTurn, GameRecording &recording);
+
+private:
+    struct GameEntry
+    {
+        uint64_t block;
+        uint64_t events;
+        std::vector<std::pair<int32_t, uint64_t>> keyframes;
+    };
+
+    std::ifstream in;
+    std::vector<GameEntry> games;
+};
+
+// Rebuilds a recorded game: loads its map, creates its players, restores the start
+// snapshot, then seeks by applying events to a flat copy of the state and restoring
+// the result once, starting from the nearest keyframe when that saves events.
+// Eliminated players keep their slot (with no territories). The engine can play on
+// from any turn reached (fork() it to keep the replay).
+class ReplayEngine : public Subject, public ILoggable
+{
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_ENGINE; }
+    explicit ReplayEngine(const GameRecording &recording);
+    ~ReplayEngine();
+    ReplayEngine(const ReplayEngine &) = delete;
+    ReplayEngine &operator=(const ReplayEngine &) = delete;
+
+    bool isReady() const { return engine != nullptr; }
+    bool seekTurn(int turn); // state at the end of turn (0 = right after setup); not before startTurn
+    int getTurn() const { return turn; }
+    GameEngine &getEngine() { return *engine; }
+    const GameRecording &getRecording() const { return recording; }
+
+private:
+    struct State
+    {
+        std::vector<int16_t> owner;
+        std::vector<int32_t> armies;
+        std::vector<int32_t> listSlot; // position of each territory in its owner's list
+        std::vector<std::vector<int32_t>> territories;
+        std::vector<int32_t> pools;
+        std::vector<uint8_t> conquered;
+        std::vector<std::vector<CardType>> hands;
+        std::vector<CardType> deck;
+        std::vector<std::pair<int, int>> truces;
+        std::vector<std::vector<GameSnapshot::PendingOrder>> orders;
+        GameRng rng;
+    };
+
+    void loadState(const GameSnapshot &snap, int atTurn, size_t atEvent);
+    void growTo(int slot);
+    void apply(const ReplayEvent &event);
+    GameSnapshot toSnapshot() const;
+
+    GameRecording recording;
+    GameEngine *engine = nullptr;
+    State state;
+    size_t cursor = 0; // next event to apply
+    int turn = 0;
+};
+
+#endif
@@ -0,0 +1,242 @@
+#include "GameEngine.h"
+#include "GameSnapshot.h"
+#include "Map.h"
+#include "Player.h"
+#include "Orders.h"
+#include "Cards.h"
+#include <algorithm>
+#include "../utils/logger.h"
+
+using namespace std;
+
+const int CARD_TYPE_COUNT = 5;
+
+bool GameSnapshot::wellFormed(int territoryCount) const
+{
+    // Every slot's entries are [offsets[i], offsets[i + 1]) of an array of size total
+    auto validOffsets = [&](const vector<int32_t> &offsets, size_t total)
+    {
+        if (static_cast<int>(offsets.size()) != playerCount + 1 || offsets.front() != 0 ||
+            static_cast<size_t>(offsets.back()) != total)
+            return false;
+        return is_sorted(offsets.begin(), offsets.end());
+    };
+    auto validSlot = [&](int slot)
+    { return slot == NO_PLAYER || (slot >= 0 && slot < playerCount); };
+    auto validTerritory = [&](int id)
+    { return id == NO_TERRITORY || (id >= 0 && id < territoryCount); };
+    auto validCard = [](CardType type)
+    { return static_cast<int>(type) >= 0 && static_cast<int>(type) < CARD_TYPE_COUNT; };
+
+    bool fits = playerCount >= (hasNeutral ? 1 : 0) && playerCount <= TruceMatrix::MAX_SLOTS && stateIndex >= -1 &&
+                static_cast<int>(owner.size()) == territoryCount && armies.size() == owner.size() &&
+                static_cast<int>(reinforcementPool.size()) == playerCount &&
+                static_cast<int>(conqueredThisTurn.size()) == playerCount &&
+                validOffsets(territoryOffsets, territoryIds.size()) && validOffsets(handOffsets, handCards.size()) &&
+                validOffsets(orderOffsets, orders.size());
+    for (size_t i = 0; fits && i < owner.size(); i++)
+        fits = validSlot(owner[i]);
+    for (size_t i = 0; fits && i < territoryIds.size(); i++)
+        fits = territoryIds[i] >= 0 && territoryIds[i] < territoryCount;
+    for (size_t i = 0; fits && i < handCards.size(); i++)
+        fits = validCard(handCards[i]);
+    for (size_t i = 0; fits && i < deck.size(); i++)
+        fits = validCard(deck[i]);
+    for (size_t i = 0; fits && i < orders.size(); i++)
+    {
+        const PendingOrder &order = orders[i];
+        fits = order.kind <= OrderKind::Negotiate && validSlot(order.issuer) && validSlot(order.other) &&
+               validTerritory(order.source) && validTerritory(order.target);
+    }
+    for (size_t i = 0; fits && i < truces.size(); i++)
+        fits = truces[i].first >= 0 && truces[i].first < playerCount && truces[i].second >= 0 &&
+               truces[i].second < playerCount;
+    return fits;
+}
+
+bool GameSnapshot::operator==(const GameSnapshot &other) const
+{
+    return playerCount == other.playerCount && hasNeutral == other.hasNeutral && stateIndex == other.stateIndex &&
+           owner == other.owner && armies == other.armies && reinforcementPool == other.reinforcementPool &&
+           conqueredThisTurn == other.conqueredThisTurn && territoryOffsets == other.territoryOffsets &&
+           territoryIds == other.territoryIds && handOffsets == other.handOffsets && handCards == other.handCards &&
+           orderOffsets == other.orderOffsets && orders == other.orders &&
+           deck == other.deck && truces == other.truces && rng == other.rng;
+}
+
+GameSnapshot GameEngine::snapshot() const
+{
+    GameSnapshot snap;
+
+    vector<Player *> slots(players);
+    if (neutralPlayer)
+        slots.push_back(neutralPlayer);
+    OrderContext context(*this);
+
+    snap.playerCount = static_cast<int>(slots.size());
+    snap.hasNeutral = neutralPlayer != nullptr;
+    for (size_t i = 0; i < states_->size(); i++)
+    {
+        if ((*states_)[i] == current_)
+            snap.stateIndex = static_cast<int>(i);
+    }
+
+    int territoryCount = gameMap ? gameMap->getTerritoriesSize() : 0;
+    snap.owner.reserve(territoryCount);
+    snap.armies.reserve(territoryCount);
+    for (int id = 0; id < territoryCount; id++)
+    {
+        Territory *territory = gameMap->getTerritoryById(id);
+        snap.owner.push_back(context.slotOf(territory->getOwner()));
+        snap.armies.push_back(territory->getArmies());
+    }
+
+    snap.territoryOffsets.push_back(0);
+    snap.handOffsets.push_back(0);
+    snap.orderOffsets.push_back(0);
+    for (Player *player : slots)
+    {
+        snap.reinforcementPool.push_back(player->getReinforcementPool());
+        snap.conqueredThisTurn.push_back(player->hasConqueredThisTurn() ? 1 : 0);
+
+        for (Territory *territory : player->getTerritories())
+            snap.territoryIds.push_back(territory->getId());
+        snap.territoryOffsets.push_back(static_cast<int32_t>(snap.territoryIds.size()));
+
+        for (Card *card : player->getHandOfCards()->getCards())
+            snap.handCards.push_back(card->getType());
+        snap.handOffsets.push_back(static_cast<int32_t>(snap.handCards.size()));
+
+        player->getOrdersList()->forEachInOrder([&](const Order *order)
+                                                { snap.orders.push_back(context.compact(*order)); });
+        snap.orderOffsets.push_back(static_cast<int32_t>(snap.orders.size()));
+    }
+
+    if (gameDeck)
+    {
+        for (Card *card : gameDeck->getCards())
+            snap.deck.push_back(card->getType());
+    }
+
+    snap.truces = truces.pairs();
+    snap.rng = rng;
+    return snap;
+}
+
+bool GameEngine::restore(const GameSnapshot &snap)
+{
+    // Check everything first so a snapshot from another game leaves this one untouched
+    int territoryCount = gameMap ? gameMap->getTerritoriesSize() : 0;
+    int slotCount = static_cast<int>(players.size()) + (snap.hasNeutral ? 1 : 0);
+    bool fits = snap.playerCount == slotCount && snap.wellFormed(territoryCount) && (snap.deck.empty() || gameDeck) &&
+                snap.stateIndex < static_cast<int>(states_->size());
+    if (!fits)
+    {
+        LOG_NOTIFY(ERROR, "Snapshot does not match this game; not restored");
+        return false;
+    }
+
+    vector<Player *> slots(players);
+    if (snap.hasNeutral)
+        slots.push_back(getNeutralPlayer());
+    else if (neutralPlayer)
+        neutralPlayer->clearTerritories();
+    OrderContext context(*this);
+
+    // Territories: owners and armies, then every player's list in its saved order
+    for (Player *player : slots)
+        player->clearTerritories();
+    for (int id = 0; id < territoryCount; id++)
+    {
+        Territory *territory = gameMap->getTerritoryById(id);
+        territory->setOwner(context.player(snap.owner[id]));
+        territory->setArmies(snap.armies[id]);
+    }
+    for (int slot = 0; slot < slotCount; slot++)
+    {
+        for (int i = snap.territoryOffsets[slot]; i < snap.territoryOffsets[slot + 1]; i++)
+            slots[slot]->addTerritory(gameMap->getTerritoryById(snap.territoryIds[i]));
+    }
+    if (gameMap)
+        gameMap->rebindContinentCounters();
+
+    // Cards: collect every card object in play, then deal them back out by type
+    vector<Card *> spare[CARD_TYPE_COUNT];
+    auto collect = [&](vector<Card *> cards)
+    {
+        for (Card *card : cards)
+            spare[static_cast<int>(card->getType())].push_back(card);
+    };
+    auto take = [&](CardType type)
+    {
+        vector<Card *> &pool = spare[static_cast<int>(type)];
+        if (pool.empty())
+            return new Card(type);
+        Card *card = pool.back();
+        pool.pop_back();
+        return card;
+    };
+    for (Player *player : slots)
+        collect(player->getHandOfCards()->releaseCards());
+    if (gameDeck)
+        collect(gameDeck->releaseCards());
+
+    for (int slot = 0; slot < slotCount; slot++)
+    {
+        Player *player = slots[slot];
+        player->setReinforcementPool(snap.reinforcementPool[slot]);
+        if (snap.conqueredThisTurn[slot])
+            player->markConqueredThisTurn();
+        else
+            player->resetConqueredFlag();
+
+        for (int i = snap.handOffsets[slot]; i < snap.handOffsets[slot + 1]; i++)
+            player->getHandOfCards()->addCard(take(snap.handCards[i]));
+
+        OrdersList *orders = player->getOrdersList();
+        orders->clear();
+        for (int i = snap.orderOffsets[slot]; i < snap.orderOffsets[slot + 1]; i++)
+            orders->add(Order::create(snap.orders[i].kind, context.paramsOf(snap.orders[i]), gameMap, this));
+    }
+    if (gameDeck)
+    {
+        for (CardType type : snap.deck)
+            gameDeck->returnCard(take(type));
+    }
+    for (vector<Card *> &pool : spare)
+    {
+        for (Card *card : pool)
+            delete card;
+    }
+
+    truces.clear();
+    for (const pair<int, int> &truce : snap.truces)
+        truces.add(truce.first, truce.second);
+    if (snap.stateIndex >= 0)
+        current_ = (*states_)[snap.stateIndex];
+    rng = snap.rng;
+    return true;
+}
+
+GameEngine *GameEngine::fork() const
+{
+    GameEngine *copy = new GameEngine();
+    copy->buildGraph();
+    if (gameMap)
+        copy->gameMap = new Map(*gameMap);
+    if (gameDeck)
+        copy->gameDeck = new Deck(*gameDeck);
+
+    for (Player *player : players)
+    {
+        Player *twin = new Player(player->getPlayerName());
+        twin->setId(player->getId());
+        if (player->getStrategy())
+            twin->setStrategy(createStrategy(player->getPlayerStrategyName(), copy));
+        copy->players.push_back(twin);
+    }
+
+    // Owners, armies, hands, orders, truces and the RNG all come from the snapshot
+    copy->restore(snapshot());
+    return copy;
+}
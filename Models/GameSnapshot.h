@@ -0,0 +1,58 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Cards.h"
+#include "CompactOrder.h"
+#include "../utils/GameRng.h"
+
+// Full mutable state of a game (see GameEngine::snapshot / restore): owners, armies,
+// reinforcement pools, hands, deck, pending orders, truces, engine state and RNG.
+// Everything is stored as ids in flat arrays, so a copy is a few vector copies and a
+// restore rebuilds the pointer graph in O(territories + cards + orders).
+//
+// Players are stored by slot: their index in the engine's player list, with the neutral
+// player (if any) in the slot after the last one. A snapshot restores only into an engine
+// with the same map and player list: the one it came from, or a GameEngine::fork().
+struct GameSnapshot
+{
+    static const int NO_PLAYER = CompactOrder::NO_PLAYER;
+    static const int NO_TERRITORY = CompactOrder::NO_TERRITORY;
+
+    // Same slots as OrderContext's, so a pending order is a CompactOrder as it stands
+    using PendingOrder = CompactOrder;
+
+    int playerCount = 0;     // slots, including the neutral player
+    bool hasNeutral = false; // the last slot is the neutral player
+    int stateIndex = -1;     // engine state, index into the state graph
+
+    // Per territory, indexed by id
+    std::vector<int16_t> owner; // player slot or NO_PLAYER
+    std::vector<int32_t> armies;
+
+    // Per player slot. Territory lists are kept in list order since strategies
+    // iterate them, as are hands; slot i's entries are [offsets[i], offsets[i + 1]).
+    std::vector<int32_t> reinforcementPool;
+    std::vector<uint8_t> conqueredThisTurn;
+    std::vector<int32_t> territoryOffsets;
+    std::vector<int32_t> territoryIds;
+    std::vector<int32_t> handOffsets;
+    std::vector<CardType> handCards;
+    std::vector<int32_t> orderOffsets;
+    std::vector<PendingOrder> orders; // each player's list in issue order
+
+    std::vector<CardType> deck;              // in draw order
+    std::vector<std::pair<int, int>> truces; // player slot pairs, smaller slot first, sorted
+    GameRng rng;
+
+    // Sizes, offsets, slots, territory ids, card types and order kinds all in range for a
+    // map of territoryCount territories; checked before any offset or id is used
+    bool wellFormed(int territoryCount) const;
+
+    bool operator==(const GameSnapshot &other) const;
+    bool operator!=(const GameSnapshot &other) const { return !(*this == other); }
+};
+
+#endif
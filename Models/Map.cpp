@@ -9,7 +9,12 @@
 #include <algorithm>
 #include <random>
 #include <cctype>
+#include <charconv>
+#include <string_view>
+#include <filesystem>
+#include "../utils/GameRng.h"
 #include "../utils/logger.h"
+#include "../utils/MappedFile.h"
 
 using namespace std;
 
@@ -18,7 +23,7 @@ Territory::Territory(const string &name, int id, int continentId, int x, int y)
     : name(name), id(id), continentId(continentId), owner(nullptr), armies(0), x(x), y(y) {}
 
 Territory::Territory(const Territory &other) : name(other.name), id(other.id), continentId(other.continentId), owner(other.owner), armies(other.armies), x(other.x),
-                                               y(other.y), adjacentIds(other.adjacentIds) {};
+                                               y(other.y), adjacentIds(other.adjacentIds), ownerSlot(other.ownerSlot) {};
 
 // Assigment operator:
 Territory &Territory::operator=(const Territory &other)
@@ -33,6 +38,11 @@ Territory &Territory::operator=(const Territory &other)
         x = other.x;
         y = other.y;
         adjacentIds = other.adjacentIds;
+        ownerSlot = other.ownerSlot;
+        continent = nullptr; // bound by the owning map
+        // The frozen slice belongs to the other territory's map
+        frozenAdjBegin = nullptr;
+        frozenAdjEnd = nullptr;
     }
     return *this;
 }
@@ -79,7 +89,8 @@ Continent::Continent(const string &name, int id, int bonusValue)
     : name(name), id(id), bonusValue(bonusValue) {}
 // Copy Constructor
 Continent::Continent(const Continent &other)
-    : name(other.name), id(other.id), bonusValue(other.bonusValue) {};
+    : name(other.name), id(other.id), bonusValue(other.bonusValue), territoryIds(other.territoryIds),
+      sortedTerritoryIds(other.sortedTerritoryIds) {};
 // Assignment Operator
 
 Continent &Continent::operator=(const Continent &other)
@@ -90,6 +101,7 @@ Continent &Continent::operator=(const Continent &other)
         id = other.id;
         bonusValue = other.bonusValue;
         territoryIds = other.territoryIds;
+        sortedTerritoryIds = other.sortedTerritoryIds;
     }
     return *this;
 }
@@ -113,39 +125,100 @@ Map &Map::operator=(const Map &other)
         territoryNameToId = other.territoryNameToId;
         continentIdToIndex = other.continentIdToIndex;
         continentNameToId = other.continentNameToId;
+        adjacencyFrozen = false;
+        if (other.adjacencyFrozen)
+            freezeAdjacency();
+        continentCountersBound = false;
     }
     return *this;
 }
 
-vector<Territory *> Map::getNeighborsOf(Territory *territory)
+TerritoryRange Map::getNeighborsOf(Territory *territory)
 {
-    return getNeighborsOf(territory->getId());
+    return neighborsOf(territory);
 }
 
-vector<Territory *> Map::getNeighborsOf(int territoryId)
+TerritoryRange Map::getNeighborsOf(int territoryId)
 {
-    vector<Territory *> neighbors;
-    Territory *territory = getTerritoryById(territoryId);
+    return neighborsOf(territoryId);
+}
 
-    if (territory == nullptr)
-    {
-        return neighbors;
-    }
+TerritoryRange Map::neighborsOf(const Territory *territory)
+{
+    return territory ? neighborsOf(territory->getId()) : TerritoryRange();
+}
+
+TerritoryRange Map::neighborsOf(int territoryId)
+{
+    if (territoryId < 0 || territoryId >= static_cast<int>(territories.size()))
+        return TerritoryRange();
+
+    // Territories or adjacencies were edited after the last freeze
+    if (!adjacencyFrozen || !territories[territoryId].hasFrozenAdjacency())
+        freezeAdjacency();
+
+    const int *base = adjacencyIds.data();
+    return TerritoryRange(base + adjacencyOffsets[territoryId],
+                         base + adjacencyOffsets[territoryId + 1],
+                         territories.data());
+}
+
+// Builds the CSR arrays from each territory's adjacency set and points every territory at its slice
+void Map::freezeAdjacency()
+{
+    adjacencyOffsets.assign(territories.size() + 1, 0);
+    adjacencyIds.clear();
 
-    const std::unordered_set<int> &adjacentIds = territory->getAdjacentIds();
-    for (int adjId : adjacentIds)
+    size_t totalEdges = 0;
+    for (const Territory &territory : territories)
+        totalEdges += territory.getAdjacentIds().size();
+    adjacencyIds.reserve(totalEdges);
+
+    for (size_t i = 0; i < territories.size(); ++i)
     {
-        Territory *neighbor = getTerritoryById(adjId);
-        if (neighbor != nullptr)
+        size_t start = adjacencyIds.size();
+        for (int adjId : territories[i].getAdjacentIds())
         {
-            neighbors.push_back(neighbor);
+            // Drop ids that do not name a territory of this map
+            if (adjId >= 0 && adjId < static_cast<int>(territories.size()))
+                adjacencyIds.push_back(adjId);
         }
+        sort(adjacencyIds.begin() + start, adjacencyIds.end());
+        adjacencyOffsets[i + 1] = static_cast<int>(adjacencyIds.size());
+    }
+
+    const int *base = adjacencyIds.data();
+    for (size_t i = 0; i < territories.size(); ++i)
+    {
+        territories[i].setFrozenAdjacency(base + adjacencyOffsets[i], base + adjacencyOffsets[i + 1]);
     }
-    return neighbors;
+    adjacencyFrozen = true;
 }
 
-Map::Map(const Map &other) : territories(other.territories), territoryNameToId(other.territoryNameToId),
-                             continentIdToIndex(other.continentIdToIndex), continentNameToId(other.continentNameToId) {}
+void Map::adoptAdjacency(vector<int> offsets, vector<int> ids)
+{
+    adjacencyOffsets = std::move(offsets);
+    adjacencyIds = std::move(ids);
+
+    const int *base = adjacencyIds.data();
+    for (size_t i = 0; i < territories.size(); ++i)
+    {
+        const int *first = base + adjacencyOffsets[i];
+        const int *last = base + adjacencyOffsets[i + 1];
+        unordered_set<int> &adjacent = territories[i].getAdjacentIds();
+        adjacent.clear();
+        adjacent.insert(first, last);
+        territories[i].setFrozenAdjacency(first, last);
+    }
+    adjacencyFrozen = true;
+}
+
+Map::Map(const Map &other) : territories(other.territories), continents(other.continents), territoryNameToId(other.territoryNameToId),
+                             continentIdToIndex(other.continentIdToIndex), continentNameToId(other.continentNameToId)
+{
+    if (other.adjacencyFrozen)
+        freezeAdjacency();
+}
 
 // Territory methods
 string Territory::getName() const { return name; }
@@ -176,12 +249,22 @@ int Territory::removeArmies(int delta)
 
 bool Territory::isAdjacentTo(int territoryId) const
 {
+    if (frozenAdjBegin != nullptr)
+        return std::binary_search(frozenAdjBegin, frozenAdjEnd, territoryId);
     return adjacentIds.find(territoryId) != adjacentIds.end();
 }
 
 void Territory::addAdjacentTerritory(int territoryId)
 {
     adjacentIds.insert(territoryId);
+    frozenAdjBegin = nullptr;
+    frozenAdjEnd = nullptr;
+}
+
+void Territory::setFrozenAdjacency(const int *begin, const int *end)
+{
+    frozenAdjBegin = begin;
+    frozenAdjEnd = end;
 }
 
 void Territory::setOwner(int playerId)
@@ -206,7 +289,8 @@ const unordered_set<int> &Continent::getTerritoryIds() const { return territoryI
 
 void Continent::addTerritory(int territoryId)
 {
-    territoryIds.insert(territoryId);
+    if (territoryIds.insert(territoryId).second)
+        sortedTerritoryIds.insert(upper_bound(sortedTerritoryIds.begin(), sortedTerritoryIds.end(), territoryId), territoryId);
 }
 
 void Continent::setBonusValue(int bonus)
@@ -214,21 +298,52 @@ void Continent::setBonusValue(int bonus)
     bonusValue = bonus;
 }
 
-std::vector<Territory *> Continent::getTerritories(Map *map) const
+int Continent::getOwnerCount(const Player *player) const
+{
+    for (const auto &entry : ownerCounts)
+    {
+        if (entry.first == player)
+            return entry.second;
+    }
+    return 0;
+}
+
+bool Continent::isControlledBy(const Player *player) const
 {
-    std::vector<Territory *> result;
-    if (!map)
-        return result;
+    return player && !territoryIds.empty() && getOwnerCount(player) == static_cast<int>(territoryIds.size());
+}
 
-    for (int territoryId : territoryIds)
+void Continent::adjustOwnerCount(const Player *player, int delta)
+{
+    if (!player)
+        return;
+    for (auto &entry : ownerCounts)
     {
-        Territory *territory = map->getTerritoryById(territoryId);
-        if (territory)
+        if (entry.first == player)
         {
-            result.push_back(territory);
+            entry.second += delta;
+            return;
         }
     }
-    return result;
+    ownerCounts.emplace_back(player, delta);
+}
+
+void Continent::clearOwnerCounts()
+{
+    ownerCounts.clear();
+}
+
+TerritoryRange Continent::getTerritories(Map *map) const
+{
+    if (!map || map->getTerritoriesSize() == 0)
+        return TerritoryRange();
+
+    // Ids are sorted, so the ones that exist in this map form one contiguous run
+    auto first = lower_bound(sortedTerritoryIds.begin(), sortedTerritoryIds.end(), 0);
+    auto last = lower_bound(first, sortedTerritoryIds.end(), map->getTerritoriesSize());
+    const int *ids = sortedTerritoryIds.data();
+    return TerritoryRange(ids + (first - sortedTerritoryIds.begin()), ids + (last - sortedTerritoryIds.begin()),
+                          map->getTerritoryById(0));
 }
 
 // Validates the entire map: connectivity, continent validity, and territory membership
@@ -240,24 +355,20 @@ bool Map::validate() const
 
     // 1. Check if map is a connected graph
     bool connected = isConnectedGraph();
-    logMessage(INFO, string("1. Map connectivity: ") + (connected ? "PASSED" : "FAILED"));
-    Notify(this, INFO, string("1. Map connectivity: ") + (connected ? "PASSED" : "FAILED"));
+    LOG_NOTIFY(INFO, "1. Map connectivity: ", (connected ? "PASSED" : "FAILED"));
 
     isValid &= connected;
 
     // 2. Check if continents are connected subgraphs
     bool continentsValid = validateContinents();
-    logMessage(INFO, string("2. Continent connectivity: ") + (continentsValid ? "PASSED" : "FAILED"));
-    Notify(this, INFO, string("2. Continent connectivity: ") + (continentsValid ? "PASSED" : "FAILED"));
+    LOG_NOTIFY(INFO, "2. Continent connectivity: ", (continentsValid ? "PASSED" : "FAILED"));
     isValid &= continentsValid;
 
     // 3. Check territory membership (each territory belongs to exactly one continent)
     bool membershipValid = validateTerritoryMembership();
-    logMessage(INFO, string("3. Territory membership: ") + (membershipValid ? "PASSED" : "FAILED"));
-    Notify(this, INFO, string("3. Territory membership: ") + (membershipValid ? "PASSED" : "FAILED"));
+    LOG_NOTIFY(INFO, "3. Territory membership: ", (membershipValid ? "PASSED" : "FAILED"));
     isValid &= membershipValid;
-    logMessage(INFO, string("Overall map validation: ") + (isValid ? "VALID" : "INVALID"));
-    Notify(this, INFO, string("Overall map validation: ") + (isValid ? "VALID" : "INVALID"));
+    LOG_NOTIFY(INFO, "Overall map validation: ", (isValid ? "VALID" : "INVALID"));
     logMessage(INFO, "======================");
 
     return isValid;
@@ -306,8 +417,7 @@ bool Map::validateContinents() const
 
         if (territoryIds.empty())
         {
-            logMessage(DEBUG, string("Continent '") + continent.getName() + "' has no territories");
-            Notify(this, DEBUG, string("Continent '") + continent.getName() + "' has no territories");
+            LOG_NOTIFY(DEBUG, "Continent '", continent.getName(), "' has no territories");
             continue;
         }
 
@@ -341,8 +451,7 @@ bool Map::validateContinents() const
         // Check if all territories in this continent were visited
         if (visited.size() != territoryIds.size())
         {
-            logMessage(ERROR, string("Continent '") + continent.getName() + "' is not connected: " + to_string(visited.size()) + "/" + to_string(territoryIds.size()) + " territories reachable");
-            Notify(this, ERROR, string("Continent '") + continent.getName() + "' is not connected: " + to_string(visited.size()) + "/" + to_string(territoryIds.size()) + " territories reachable");
+            LOG_NOTIFY(ERROR, "Continent '", continent.getName(), "' is not connected: ", visited.size(), "/", territoryIds.size(), " territories reachable");
             return false;
         }
     }
@@ -414,6 +523,8 @@ void Map::addTerritory(const Territory &t)
     int index = territories.size();
     territories.push_back(t);
     territoryNameToId[t.getName()] = index;
+    adjacencyFrozen = false; // push_back may have moved every territory
+    continentCountersBound = false;
 }
 
 // Adds a continent to the map with hash map indexing
@@ -423,6 +534,37 @@ void Map::addContinent(const Continent &c)
     continents.push_back(c);
     continentIdToIndex[c.getId()] = index;
     continentNameToId[c.getName()] = c.getId();
+
+    // push_back may have moved every continent: drop the territories' links until rebound
+    if (continentCountersBound)
+    {
+        for (Territory &territory : territories)
+            territory.setContinent(nullptr);
+        continentCountersBound = false;
+    }
+}
+
+void Map::bindContinentCounters()
+{
+    if (continentCountersBound)
+        return;
+
+    for (Continent &continent : continents)
+        continent.clearOwnerCounts();
+    for (Territory &territory : territories)
+    {
+        Continent *continent = getContinentById(territory.getContinentId());
+        territory.setContinent(continent);
+        if (continent)
+            continent->adjustOwnerCount(territory.getOwner(), 1);
+    }
+    continentCountersBound = true;
+}
+
+void Map::rebindContinentCounters()
+{
+    continentCountersBound = false;
+    bindContinentCounters();
 }
 
 // Territory access methods with O(1) performance
@@ -482,6 +624,10 @@ std::vector<Continent> &Map::getContinents()
 // Helper method to print map statistics
 void Map::printMapStatistics() const
 {
+    // Every tournament game loads a map; quiet console modes skip the listing
+    if (!consoleEnabled(INFO))
+        return;
+
     cout << "\n=== MAP STATISTICS ===" << endl;
     cout << "Territories: " << territories.size() << endl;
     cout << "Continents: " << continents.size() << endl;
@@ -496,104 +642,161 @@ void Map::printMapStatistics() const
          << endl;
 }
 
+// ---------- Map file parsing helpers ----------
+// The loader works on string_views into the mapped file; only names that end up
+// stored in the Map (territory/continent names) are copied into std::strings.
+
+static string_view trimView(string_view s)
+{
+    size_t first = s.find_first_not_of(WHITE_SPACE);
+    if (first == string_view::npos)
+        return string_view();
+    size_t last = s.find_last_not_of(WHITE_SPACE);
+    return s.substr(first, last - first + 1);
+}
+
+// Splits off the text up to the next delimiter; returns false once nothing is left
+static bool nextToken(string_view &rest, char delimiter, string_view &token)
+{
+    if (rest.empty())
+        return false;
+    size_t pos = rest.find(delimiter);
+    if (pos == string_view::npos)
+    {
+        token = rest;
+        rest = string_view();
+    }
+    else
+    {
+        token = rest.substr(0, pos);
+        rest.remove_prefix(pos + 1);
+    }
+    return true;
+}
+
+// Leading integer of a field (like stoi: optional sign, trailing text ignored)
+static bool parseIntView(string_view s, int &value)
+{
+    s = trimView(s);
+    if (!s.empty() && s.front() == '+')
+        s.remove_prefix(1);
+    auto result = from_chars(s.data(), s.data() + s.size(), value);
+    return result.ec == errc();
+}
+
+static bool equalsIgnoreCase(string_view a, string_view b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i])))
+            return false;
+    }
+    return true;
+}
+
+static Section sectionFromHeader(string_view line)
+{
+    if (equalsIgnoreCase(line, CONTINENT_HEADER)) // [BUG-FIX] check if equal [Continent] to lower case
+        return CONTINENTS;
+    if (equalsIgnoreCase(line, TERRITORIES_HEADER)) // [BUG-FIX] check if equal [Territories] to lower case
+        return TERRITORIES;
+    return NONE;
+}
+
+// "<name>=<bonus>"; returns false if the line has no '='
+static bool parseContinentLine(string_view line, string_view &name, int &bonusValue, bool &bonusValid)
+{
+    size_t eq = line.find('=');
+    if (eq == string_view::npos)
+        return false;
+    name = trimView(line.substr(0, eq));
+    bonusValue = 0;
+    bonusValid = parseIntView(line.substr(eq + 1), bonusValue);
+    return true;
+}
+
+// "<name>,<x>,<y>,<continent>[,<adjacent>...]"; adjacent names are appended to adjacentNames.
+// Returns false if one of the four leading fields is missing.
+static bool parseTerritoryLine(string_view line, string_view &name, int &x, int &y, bool &coordsValid,
+                               string_view &continentName, vector<string_view> &adjacentNames)
+{
+    string_view rest = line;
+    string_view xField, yField;
+    if (!nextToken(rest, ',', name) || !nextToken(rest, ',', xField) ||
+        !nextToken(rest, ',', yField) || !nextToken(rest, ',', continentName))
+        return false;
+
+    name = trimView(name);
+    continentName = trimView(continentName);
+    x = 0;
+    y = 0;
+    coordsValid = parseIntView(xField, x) && parseIntView(yField, y);
+    if (!coordsValid)
+    {
+        x = 0;
+        y = 0;
+    }
+
+    string_view adjName;
+    while (nextToken(rest, ',', adjName))
+    {
+        adjName = trimView(adjName);
+        if (!adjName.empty())
+            adjacentNames.push_back(adjName);
+    }
+    return true;
+}
+
 // MapLoader constructor: initializes a map loader.
 MapLoader::MapLoader() {}
 MapLoader::MapLoader(const MapLoader &other) : MapLoader() {}
 MapLoader::~MapLoader() {};
-// Handles the current parsing state and updates the map accordingly.
+// Handles a single line of the given section (adjacencies are not resolved here; see loadMap).
 Map *MapLoader::handleCurrentState(Section currentState, const string &line, Map *map)
 {
     if (currentState == CONTINENTS)
     {
-        size_t eq = line.find('=');
-        if (eq != string::npos)
+        string_view name;
+        int bonusValue = 0;
+        bool bonusValid = false;
+        if (parseContinentLine(line, name, bonusValue, bonusValid))
         {
-            string name = line.substr(0, eq);
-            string bonusStr = line.substr(eq + 1);
-            int bonusValue = 0;
-            try
-            {
-                bonusValue = stoi(bonusStr);
-            }
-            catch (const exception &)
+            if (!bonusValid)
             {
                 cout << "Warning: Invalid bonus value for continent " << name << endl;
             }
-
             int id = map->getContinentsSize();
-            map->addContinent(Continent(name, id, bonusValue));
-            Notify(this, DEBUG, "Added continent: " + name + "(ID: " + to_string(id) + ", Bonus: " + to_string(bonusValue) + ")");
+            map->addContinent(Continent(string(name), id, bonusValue));
+            LOG_OBSERVERS(DEBUG, "Added continent: ", name, "(ID: ", id, ", Bonus: ", bonusValue, ")");
         }
     }
     else if (currentState == TERRITORIES)
     {
-        stringstream ss(line);
-        string name, xStr, yStr, continentName;
-
-        // Parse basic territory info
-        if (!getline(ss, name, ','))
-            return map;
-        if (!getline(ss, xStr, ','))
-            return map;
-        if (!getline(ss, yStr, ','))
-            return map;
-        if (!getline(ss, continentName, ','))
+        string_view name, continentName;
+        int x = 0, y = 0;
+        bool coordsValid = false;
+        vector<string_view> adjacentNames;
+        if (!parseTerritoryLine(line, name, x, y, coordsValid, continentName, adjacentNames))
             return map;
 
         // Find continent using O(1) lookup
-        Continent *continent = map->getContinentByName(continentName);
-
+        Continent *continent = map->getContinentByName(string(continentName));
         if (!continent)
         {
-            logMessage(ERROR, string("Error: Unknown continent '") + continentName + "' for territory '" + name + "'");
-            Notify(this, ERROR, string("Error: Unknown continent '") + continentName + "' for territory '" + name + "'");
+            LOG_NOTIFY(ERROR, "Error: Unknown continent '", continentName, "' for territory '", name, "'");
             delete map;
             return nullptr;
         }
-
-        // Create territory with unique ID and coordinates
-        int territoryId = map->getTerritoriesSize();
-        int x = 0, y = 0;
-        try
-        {
-            x = stoi(xStr);
-            y = stoi(yStr);
-        }
-        catch (const exception &)
-        {
-            logMessage(WARNING, string("Warning: Invalid coordinates for territory ") + name);
-            Notify(this, WARNING, string("Warning: Invalid coordinates for territory ") + name);
-        }
-        Territory territory(name, territoryId, continent->getId(), x, y);
-
-        // Parse adjacent territories
-        string adjName;
-        vector<string> adjacentNames;
-        while (getline(ss, adjName, ','))
+        if (!coordsValid)
         {
-            // Remove whitespace
-            adjName.erase(0, adjName.find_first_not_of(WHITE_SPACE));
-            adjName.erase(adjName.find_last_not_of(WHITE_SPACE) + 1);
-            if (!adjName.empty())
-            {
-                adjacentNames.push_back(adjName);
-            }
+            LOG_NOTIFY(WARNING, "Warning: Invalid coordinates for territory ", name);
         }
 
-        logMessage(DEBUG, string("Territory: ") + name + " -> " + continentName + " (Adjacent: " + to_string(adjacentNames.size()) + ")");
-        Notify(this, DEBUG, string("Territory: ") + name + " -> " + continentName + " (Adjacent: " + to_string(adjacentNames.size()) + ")");
-        // Add territory to map
-        map->addTerritory(territory);
+        int territoryId = map->getTerritoriesSize();
+        map->addTerritory(Territory(string(name), territoryId, continent->getId(), x, y));
         continent->addTerritory(territoryId);
-
-        // Store adjacent names for later processing (after all territories are loaded)
-        // We'll do a second pass to establish adjacencies
-        if (!adjacentNames.empty())
-        {
-            // Store this info temporarily - we'll handle it in loadMap
-            Territory *addedTerritory = map->getTerritoryById(territoryId);
-            // For now, we can't resolve adjacencies until all territories are loaded
-        }
     }
     return map;
 }
@@ -601,16 +804,7 @@ Map *MapLoader::handleCurrentState(Section currentState, const string &line, Map
 // Returns the Section enum value based on the header line.
 Section MapLoader::getSectionFromHeader(const string &line)
 {
-    string lowercasedString = line; // create a copy of original string
-    transform(lowercasedString.begin(), lowercasedString.end(), lowercasedString.begin(),
-              [](unsigned char c)
-              { return tolower(c); });
-
-    if (lowercasedString == CONTINENT_HEADER) // [BUG-FIX] check if equal [Continent] to lower case
-        return CONTINENTS;
-    if (lowercasedString == TERRITORIES_HEADER) // [BUG-FIX] check if equal [Territories] to lower case
-        return TERRITORIES;
-    return NONE;
+    return sectionFromHeader(line);
 }
 
 const char *sectionToString(Section section)
@@ -629,146 +823,132 @@ const char *sectionToString(Section section)
 }
 
 // Loads a map from a file and returns a pointer to the Map object.
+// A fresh precompiled .wzb in the map cache is used instead of parsing the text.
 Map *MapLoader::loadMap(const string &filename)
 {
-    ifstream file(filename);
+    if (hasFreshBinary(filename))
+    {
+        std::error_code ec;
+        uint64_t sourceSize = filesystem::file_size(filename, ec);
+        Map *map = loadBinaryMap(binaryPathFor(filename), sourceSize);
+        if (map)
+            return map;
+        logMessage(WARNING, "Precompiled map unusable, parsing " + filename);
+    }
+    return loadTextMap(filename);
+}
+
+// Single pass over the mapped file; adjacency names are resolved afterwards against
+// views of the territory names, so no per-line or per-name strings are built.
+Map *MapLoader::loadTextMap(const string &filename)
+{
+    MappedFile file(filename);
 
-    if (!file.is_open())
+    if (!file.isOpen())
     {
-        logMessage(ERROR, string("Error: Cannot open file ") + filename);
-        Notify(this, ERROR, string("Error: Cannot open file ") + filename);
+        LOG_NOTIFY(ERROR, "Error: Cannot open file ", filename);
         return nullptr;
     }
 
+    LOG_NOTIFY(INFO, "Loading map from: ", filename);
+
     Map *map = new Map();
-    string line;
     Section currentSection = NONE;
 
-    // Store territory adjacency info for second pass
-    vector<pair<string, vector<string>>> territoryAdjacencies;
+    // Interned names: views into the mapped file -> id
+    unordered_map<string_view, int> continentIds;
+    unordered_map<string_view, int> territoryIds;
 
-    logMessage(INFO, string("Loading map from: ") + filename);
-    Notify(this, INFO, string("Loading map from: ") + filename);
+    // Adjacency names of territory i are adjacentNames[adjacencyStart[i] .. adjacencyStart[i + 1])
+    vector<string_view> adjacentNames;
+    vector<size_t> adjacencyStart;
 
-    // First pass: Load continents and territories
-    while (getline(file, line))
+    string_view rest = file.contents();
+    string_view line;
+    while (nextToken(rest, '\n', line))
     {
-        // Remove whitespace
-        line.erase(0, line.find_first_not_of(WHITE_SPACE));
-        line.erase(line.find_last_not_of(WHITE_SPACE) + 1);
-
+        line = trimView(line);
         if (line.empty())
             continue;
 
-        Section newSection = getSectionFromHeader(line);
+        Section newSection = sectionFromHeader(line);
         if (newSection != NONE)
         {
-            string strSection = sectionToString(newSection);
-            Notify(this, DEBUG, string("Detected Section: ") + strSection);
+            LOG_OBSERVERS(DEBUG, "Detected Section: ", sectionToString(newSection));
             currentSection = newSection;
             continue;
         }
 
-        // Handle territories with adjacency storage
-        if (currentSection == TERRITORIES)
+        if (currentSection == CONTINENTS)
         {
-            stringstream ss(line);
-            string name, xStr, yStr, continentName;
-
-            if (!getline(ss, name, ','))
-                continue;
-            if (!getline(ss, xStr, ','))
-                continue;
-            if (!getline(ss, yStr, ','))
+            string_view name;
+            int bonusValue = 0;
+            bool bonusValid = false;
+            if (!parseContinentLine(line, name, bonusValue, bonusValid))
                 continue;
-            if (!getline(ss, continentName, ','))
+            if (!bonusValid)
+            {
+                cout << "Warning: Invalid bonus value for continent " << name << endl;
+            }
+            int id = map->getContinentsSize();
+            map->addContinent(Continent(string(name), id, bonusValue));
+            continentIds[name] = id;
+        }
+        else if (currentSection == TERRITORIES)
+        {
+            string_view name, continentName;
+            int x = 0, y = 0;
+            bool coordsValid = false;
+            size_t firstAdjacent = adjacentNames.size();
+            if (!parseTerritoryLine(line, name, x, y, coordsValid, continentName, adjacentNames))
                 continue;
 
-            // Find continent
-            Continent *continent = map->getContinentByName(continentName);
-            if (!continent)
+            auto continentIt = continentIds.find(continentName);
+            if (continentIt == continentIds.end())
             {
                 cerr << "Error: Unknown continent '" << continentName << "' for territory '" << name << "'" << endl;
                 delete map;
                 return nullptr;
             }
-
-            // Create territory with coordinates
-            int territoryId = map->getTerritoriesSize();
-            int x = 0, y = 0;
-            try
-            {
-                x = stoi(xStr);
-                y = stoi(yStr);
-            }
-            catch (const exception &)
+            if (!coordsValid)
             {
                 cout << "Warning: Invalid coordinates for territory " << name << endl;
             }
-            Territory territory(name, territoryId, continent->getId(), x, y);
 
-            // Parse and store adjacent territories for second pass
-            string adjName;
-            vector<string> adjacentNames;
-            while (getline(ss, adjName, ','))
-            {
-                adjName.erase(0, adjName.find_first_not_of(WHITE_SPACE));
-                adjName.erase(adjName.find_last_not_of(WHITE_SPACE) + 1);
-                if (!adjName.empty())
-                {
-                    adjacentNames.push_back(adjName);
-                }
-            }
-
-            // Store for second pass
-            territoryAdjacencies.push_back({name, adjacentNames});
-
-            // Add territory to map
-            map->addTerritory(territory);
-            continent->addTerritory(territoryId);
-
-            Notify(this, DEBUG, string("Territory: ") + name + " -> " + continentName + " (Adjacent: " + to_string(adjacentNames.size()) + ")");
-        }
-        else
-        {
-            // Handle other sections normally
-            map = handleCurrentState(currentSection, line, map);
-            if (!map)
-            {
-                return nullptr;
-            }
+            int territoryId = map->getTerritoriesSize();
+            map->addTerritory(Territory(string(name), territoryId, continentIt->second, x, y));
+            map->getContinentById(continentIt->second)->addTerritory(territoryId);
+            territoryIds[name] = territoryId;
+            adjacencyStart.push_back(firstAdjacent);
         }
     }
-
-    file.close();
+    adjacencyStart.push_back(adjacentNames.size());
 
     // Second pass: Establish adjacencies
-    logMessage(DEBUG, "Establishing adjacencies...");
-    for (const auto &territoryAdj : territoryAdjacencies)
+    LOG_MESSAGE(DEBUG, "Establishing adjacencies...");
+    for (size_t territoryId = 0; territoryId + 1 < adjacencyStart.size(); ++territoryId)
     {
-        const string &territoryName = territoryAdj.first;
-        const vector<string> &adjacentNames = territoryAdj.second;
-
-        Territory *territory = map->getTerritoryByName(territoryName);
-        if (!territory)
-            continue;
-
-        for (const string &adjName : adjacentNames)
+        Territory *territory = map->getTerritoryById(static_cast<int>(territoryId));
+        for (size_t i = adjacencyStart[territoryId]; i < adjacencyStart[territoryId + 1]; ++i)
         {
-            Territory *adjTerritory = map->getTerritoryByName(adjName);
-            if (adjTerritory)
+            auto adjIt = territoryIds.find(adjacentNames[i]);
+            if (adjIt != territoryIds.end())
             {
+                Territory *adjTerritory = map->getTerritoryById(adjIt->second);
                 territory->addAdjacentTerritory(adjTerritory->getId());
                 // Make adjacency bidirectional
                 adjTerritory->addAdjacentTerritory(territory->getId());
             }
             else
             {
-                logMessage(WARNING, string("Adjacent territory '") + adjName + "' not found for '" + territoryName + "'");
+                logMessage(WARNING, "Adjacent territory '" + string(adjacentNames[i]) + "' not found for '" + territory->getName() + "'");
             }
         }
     }
 
+    map->freezeAdjacency();
+
+    LOG_OBSERVERS(DEBUG, "Parsed ", map->getContinentsSize(), " continents and ", map->getTerritoriesSize(), " territories");
     logMessage(INFO, "Map loaded successfully!");
     map->printMapStatistics();
 
@@ -780,20 +960,20 @@ void Map::distributeTerritories(vector<Player *> &players)
 {
     if (players.empty() || territories.empty())
     {
-        logMessage(ERROR, "Cannot distribute territories: no players or no territories available.");
-        Notify(this, ERROR, "Cannot distribute territories: no players or no territories available.");
+        LOG_NOTIFY(ERROR, "Cannot distribute territories: no players or no territories available.");
         return;
     }
 
+    // Bind first so every transfer below keeps the continent owner counters current
+    bindContinentCounters();
+
     // Create a shuffled list of territory indices
     vector<int> territoryIndices;
     for (size_t i = 0; i < territories.size(); ++i)
     {
         territoryIndices.push_back(i);
     }
-    random_device rd;
-    mt19937 g(rd());
-    shuffle(territoryIndices.begin(), territoryIndices.end(), g);
+    shuffle(territoryIndices.begin(), territoryIndices.end(), currentGameRng());
 
     // Distribute territories in round-robin fashion
     size_t playerIndex = 0;
@@ -801,11 +981,8 @@ void Map::distributeTerritories(vector<Player *> &players)
     {
         Territory *territory = &territories[territoryIdx];
 
-        // Assign territory to current player using the new Player* setter
-        territory->setOwner(players[playerIndex]);
-
-        // Add territory pointer to player's collection using addTerritory method
-        players[playerIndex]->addTerritory(territory);
+        // Assign territory to current player (sets the owner and updates both territory lists)
+        Player::transferTerritory(territory, players[playerIndex]);
 
         // Move to next player (round-robin)
         playerIndex = (playerIndex + 1) % players.size();
@@ -821,7 +998,6 @@ void Map::distributeTerritories(vector<Player *> &players)
             if (territory.getOwner() == players[i])
                 count++;
         }
-        logMessage(INFO, string("  ") + players[i]->getPlayerName() + ": " + to_string(count) + " territories");
-        Notify(this, INFO, string("  ") + players[i]->getPlayerName() + ": " + to_string(count) + " territories");
+        LOG_NOTIFY(INFO, "  ", players[i]->getPlayerName(), ": ", count, " territories");
     }
 }
\ No newline at end of file
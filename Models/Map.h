@@ -2,6 +2,9 @@
 #define MAP_H
 #include <string>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <unordered_map>
 #include <unordered_set>
 #include "Player.h"
@@ -9,6 +12,8 @@
 
 class Player;
 class Map;
+class Territory;
+class Continent;
 
 enum Section
 {
@@ -21,6 +26,56 @@ const std::string WHITE_SPACE = " \t\r\n";
 const std::string CONTINENT_HEADER = "[continents]";
 const std::string TERRITORIES_HEADER = "[territories]";
 
+// Non-owning view over a sorted array of territory ids, iterated as Territory pointers
+// (a territory's id is its index in the map). Used for a territory's slice of the frozen
+// CSR adjacency and for a continent's members. No allocation; invalidated if the map changes.
+class TerritoryRange
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Territory *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Territory *const *;
+        using reference = Territory *;
+
+        iterator(const int *pos, Territory *territories) : pos(pos), territories(territories) {}
+        Territory *operator*() const;
+        iterator &operator++()
+        {
+            ++pos;
+            return *this;
+        }
+        bool operator!=(const iterator &other) const { return pos != other.pos; }
+        bool operator==(const iterator &other) const { return pos == other.pos; }
+
+    private:
+        const int *pos;
+        Territory *territories;
+    };
+
+    TerritoryRange() : first(nullptr), last(nullptr), territories(nullptr) {}
+    TerritoryRange(const int *first, const int *last, Territory *territories)
+        : first(first), last(last), territories(territories) {}
+
+    iterator begin() const { return iterator(first, territories); }
+    iterator end() const { return iterator(last, territories); }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+    Territory *operator[](std::size_t i) const;
+
+    // Territory ids, sorted ascending
+    const int *idsBegin() const { return first; }
+    const int *idsEnd() const { return last; }
+
+private:
+    const int *first;
+    const int *last;
+    Territory *territories;
+};
+
 class Territory
 {
 private:
@@ -33,6 +88,13 @@ private:
     int x;
     int y;
     std::unordered_set<int> adjacentIds; // Using set for O(1) lookup and no duplicates
+    // Sorted slice of the owning map's CSR neighbor array (set by Map::freezeAdjacency)
+    const int *frozenAdjBegin = nullptr;
+    const int *frozenAdjEnd = nullptr;
+    // Position of this territory in its owner's territory list, for O(1) swap-remove (-1 = unlisted)
+    int ownerSlot = -1;
+    // Continent whose owner counters track this territory (set by Map::bindContinentCounters)
+    Continent *continent = nullptr;
 
 public:
     // Constructor
@@ -58,14 +120,23 @@ public:
     int getX() const;
     int getY() const;
     const std::unordered_set<int> &getAdjacentIds() const;
+    bool hasFrozenAdjacency() const { return frozenAdjBegin != nullptr; }
     Player *getOwner() const { return owner; }
+    int getOwnerSlot() const { return ownerSlot; }
+    Continent *getContinent() const { return continent; }
     // setters
-    void addAdjacentTerritory(int territoryId);
+    void addAdjacentTerritory(int territoryId); // drops the frozen slice until the map refreezes
+    void setFrozenAdjacency(const int *begin, const int *end);
     void setOwner(int playerId);
     void setArmies(int armyCount);
     void setOwner(Player *player) { owner = player; }
+    void setOwnerSlot(int slot) { ownerSlot = slot; } // maintained by Player's territory list
+    void setContinent(Continent *c) { continent = c; }
 };
 
+inline Territory *TerritoryRange::iterator::operator*() const { return territories + *pos; }
+inline Territory *TerritoryRange::operator[](std::size_t i) const { return territories + first[i]; }
+
 class Continent
 {
 private:
@@ -74,6 +145,10 @@ private:
     int id;
     int bonusValue;
     std::unordered_set<int> territoryIds; // Using set for O(1) operations
+    std::vector<int> sortedTerritoryIds;  // Same ids, sorted, backing getTerritories
+    // How many of this continent's territories each player owns, kept up to date by
+    // Player::transferTerritory. A handful of players, so a flat list beats a hash map.
+    std::vector<std::pair<const Player *, int>> ownerCounts;
 
 public:
     // Constructor
@@ -92,14 +167,24 @@ public:
     int getBonusValue() const;
     std::unordered_set<int> &getTerritoryIds();
     const std::unordered_set<int> &getTerritoryIds() const;
-    std::vector<Territory *> getTerritories(Map *map) const; // Get actual Territory pointers
+    const std::vector<int> &getSortedTerritoryIds() const { return sortedTerritoryIds; }
+    TerritoryRange getTerritories(Map *map) const; // Member Territory pointers, without allocating
     // setters
     void addTerritory(int territoryId);
     void setBonusValue(int bonus);
+
+    // Owner counters
+    int getOwnerCount(const Player *player) const;
+    bool isControlledBy(const Player *player) const; // owns every territory, O(players)
+    void adjustOwnerCount(const Player *player, int delta);
+    void clearOwnerCounts();
 };
 
 class Map : public Subject, public ILoggable
 {
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_MAP; }
+
 private:
     // Obj property
     std::vector<Territory> territories;
@@ -110,6 +195,15 @@ private:
     std::unordered_map<int, int> continentIdToIndex;        // continent id -> continent index
     std::unordered_map<std::string, int> continentNameToId; // continent name -> continent id
 
+    // Compressed sparse row adjacency: neighbors of territory i are
+    // adjacencyIds[adjacencyOffsets[i] .. adjacencyOffsets[i + 1]), sorted ascending
+    std::vector<int> adjacencyOffsets;
+    std::vector<int> adjacencyIds;
+    bool adjacencyFrozen = false;
+
+    // True while every territory points at its continent and the owner counters are exact
+    bool continentCountersBound = false;
+
 public:
     // Constructor
     Map();
@@ -148,21 +242,51 @@ public:
 
     // distributeTerritories - distributes all territories fairly among players
     void distributeTerritories(std::vector<Player *> &players);
-    std::vector<Territory *> getNeighborsOf(Territory *territory);
-    std::vector<Territory *> getNeighborsOf(int territoryId);
+    TerritoryRange getNeighborsOf(Territory *territory); // same as neighborsOf
+    TerritoryRange getNeighborsOf(int territoryId);
+
+    // Adjacency freezing: builds the CSR arrays from the per-territory sets.
+    // neighborsOf refreezes on demand if territories or adjacencies changed since.
+    void freezeAdjacency();
+    // Installs already-built CSR arrays (ids sorted per territory), e.g. from a precompiled map
+    void adoptAdjacency(std::vector<int> offsets, std::vector<int> ids);
+    bool isAdjacencyFrozen() const { return adjacencyFrozen; }
+    TerritoryRange neighborsOf(const Territory *territory);
+    TerritoryRange neighborsOf(int territoryId);
+
+    // Continent owner counters: counts every territory's current owner and links each
+    // territory to its continent so later transfers update the counts incrementally.
+    // No-op while already bound; adding territories or continents unbinds.
+    void bindContinentCounters();
+    void rebindContinentCounters(); // recounts from scratch, e.g. after owners were set directly
+    bool areContinentCountersBound() const { return continentCountersBound; }
 };
 
 class MapLoader : public Subject, public ILoggable
 {
 public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_MAP; }
     // Constructor
     MapLoader();
     ~MapLoader();
     // copy Constructor
     MapLoader(const MapLoader &other);
+    // Loads a .map file; uses its precompiled .wzb from the cache directory instead when that one is fresh
     Map *loadMap(const std::string &filename);
     Map *handleCurrentState(Section currentState, const std::string &line, Map *map);
     Section getSectionFromHeader(const std::string &line);
+
+    // Precompiled binary maps (see MapBinaryFormat.h). They are kept in a cache directory,
+    // never next to the .map, so map directories may be read-only or shared.
+    static std::string binaryCacheDir();
+    static std::string binaryPathFor(const std::string &mapFile);
+    bool hasFreshBinary(const std::string &mapFile) const;
+    bool convertToBinary(const std::string &mapFile); // text .map -> .wzb in the cache
+    bool writeBinaryMap(Map &map, const std::string &binaryFile, uint64_t sourceSize);
+    Map *loadBinaryMap(const std::string &binaryFile, uint64_t expectedSourceSize);
+
+private:
+    Map *loadTextMap(const std::string &filename);
 };
 
 #endif // MAP_H
\ No newline at end of file
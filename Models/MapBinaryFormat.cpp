@@ -0,0 +1,284 @@
+#include "Map.h"
+#include "MapBinaryFormat.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#include "../utils/logger.h"
+#include "../utils/MappedFile.h"
+
+using namespace std;
+
+// $WARZONE_MAP_CACHE, or warzone-map-cache in the system temp directory
+string MapLoader::binaryCacheDir()
+{
+    if (const char *dir = getenv("WARZONE_MAP_CACHE"))
+    {
+        if (*dir)
+            return dir;
+    }
+    std::error_code ec;
+    filesystem::path temp = filesystem::temp_directory_path(ec);
+    return ((ec ? filesystem::path(".") : temp) / "warzone-map-cache").string();
+}
+
+// "Maps/alberta.map" -> "<cache>/alberta-<hash of the absolute path>.wzb", so maps with
+// the same name in different directories do not share a file
+string MapLoader::binaryPathFor(const string &mapFile)
+{
+    filesystem::path source(mapFile);
+    std::error_code ec;
+    filesystem::path absolute = filesystem::absolute(source, ec);
+    string key = (ec ? source : absolute.lexically_normal()).string();
+
+    uint64_t hash = 1469598103934665603ULL; // FNV-1a: the same name on every run
+    for (unsigned char c : key)
+        hash = (hash ^ c) * 1099511628211ULL;
+    char suffix[18];
+    snprintf(suffix, sizeof(suffix), "-%016llx", static_cast<unsigned long long>(hash));
+    return (filesystem::path(binaryCacheDir()) / (source.stem().string() + suffix + WZB_EXTENSION)).string();
+}
+
+// A precompiled map is fresh when it exists and is not older than its .map source
+bool MapLoader::hasFreshBinary(const string &mapFile) const
+{
+    std::error_code ec;
+    string binaryFile = binaryPathFor(mapFile);
+    if (binaryFile == mapFile || !filesystem::exists(binaryFile, ec) || !filesystem::exists(mapFile, ec))
+        return false;
+
+    auto binaryTime = filesystem::last_write_time(binaryFile, ec);
+    if (ec)
+        return false;
+    auto sourceTime = filesystem::last_write_time(mapFile, ec);
+    if (ec)
+        return false;
+    return binaryTime >= sourceTime;
+}
+
+// Parses the text map once and writes its .wzb to the cache directory
+bool MapLoader::convertToBinary(const string &mapFile)
+{
+    Map *map = loadTextMap(mapFile);
+    if (!map)
+        return false;
+
+    std::error_code ec;
+    uint64_t sourceSize = filesystem::file_size(mapFile, ec);
+    if (!ec)
+        filesystem::create_directories(binaryCacheDir(), ec);
+    bool written = !ec && writeBinaryMap(*map, binaryPathFor(mapFile), sourceSize);
+    delete map;
+    return written;
+}
+
+bool MapLoader::writeBinaryMap(Map &map, const string &binaryFile, uint64_t sourceSize)
+{
+    vector<WzbTerritory> territoryTable;
+    vector<WzbContinent> continentTable;
+    vector<int32_t> adjacencyOffsets(1, 0);
+    vector<int32_t> adjacencyIds;
+    vector<int32_t> continentMembers;
+    string strings;
+    unordered_map<string, uint32_t> internedNames;
+
+    auto intern = [&](const string &name) -> uint32_t
+    {
+        auto it = internedNames.find(name);
+        if (it != internedNames.end())
+            return it->second;
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings += name;
+        internedNames.emplace(name, offset);
+        return offset;
+    };
+
+    for (int i = 0; i < map.getTerritoriesSize(); ++i)
+    {
+        Territory *territory = map.getTerritoryById(i);
+        WzbTerritory entry;
+        entry.nameOffset = intern(territory->getName());
+        entry.nameLength = static_cast<uint32_t>(territory->getName().size());
+        entry.continentId = territory->getContinentId();
+        entry.x = territory->getX();
+        entry.y = territory->getY();
+        territoryTable.push_back(entry);
+
+        TerritoryRange neighbors = map.neighborsOf(i);
+        adjacencyIds.insert(adjacencyIds.end(), neighbors.idsBegin(), neighbors.idsEnd());
+        adjacencyOffsets.push_back(static_cast<int32_t>(adjacencyIds.size()));
+    }
+
+    for (int i = 0; i < map.getContinentsSize(); ++i)
+    {
+        Continent *continent = map.getContinentByIndex(i);
+        WzbContinent entry;
+        entry.nameOffset = intern(continent->getName());
+        entry.nameLength = static_cast<uint32_t>(continent->getName().size());
+        entry.bonusValue = continent->getBonusValue();
+        entry.firstMember = static_cast<uint32_t>(continentMembers.size());
+        entry.memberCount = static_cast<uint32_t>(continent->getSortedTerritoryIds().size());
+        continentMembers.insert(continentMembers.end(), continent->getSortedTerritoryIds().begin(), continent->getSortedTerritoryIds().end());
+        continentTable.push_back(entry);
+    }
+
+    WzbHeader header;
+    memcpy(header.magic, WZB_MAGIC, sizeof(header.magic));
+    header.version = WZB_VERSION;
+    header.byteOrderMark = WZB_BYTE_ORDER_MARK;
+    header.territoryCount = static_cast<uint32_t>(territoryTable.size());
+    header.continentCount = static_cast<uint32_t>(continentTable.size());
+    header.adjacencyCount = static_cast<uint32_t>(adjacencyIds.size());
+    header.memberCount = static_cast<uint32_t>(continentMembers.size());
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+    header.sourceSize = sourceSize;
+
+    // Write to a temporary file first so readers never see a half-written map. Its name is
+    // this process's and thread's own, since tournament workers (or processes sharing
+    // WARZONE_MAP_CACHE) may precompile the same map at once; the last rename wins whole.
+#ifdef _WIN32
+    long processId = _getpid();
+#else
+    long processId = getpid();
+#endif
+    string tempFile = binaryFile + "." + to_string(processId) + "." +
+                      to_string(hash<thread::id>()(this_thread::get_id())) + ".tmp";
+    {
+        ofstream out(tempFile, ios::binary | ios::trunc);
+        if (!out.is_open())
+        {
+            LOG_NOTIFY(WARNING, "Cannot write precompiled map: ", binaryFile);
+            return false;
+        }
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(territoryTable.data()), territoryTable.size() * sizeof(WzbTerritory));
+        out.write(reinterpret_cast<const char *>(continentTable.data()), continentTable.size() * sizeof(WzbContinent));
+        out.write(reinterpret_cast<const char *>(adjacencyOffsets.data()), adjacencyOffsets.size() * sizeof(int32_t));
+        out.write(reinterpret_cast<const char *>(adjacencyIds.data()), adjacencyIds.size() * sizeof(int32_t));
+        out.write(reinterpret_cast<const char *>(continentMembers.data()), continentMembers.size() * sizeof(int32_t));
+        out.write(strings.data(), strings.size());
+        if (!out.good())
+        {
+            out.close();
+            std::error_code ec;
+            filesystem::remove(tempFile, ec);
+            logMessage(WARNING, "Cannot write precompiled map: " + binaryFile);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    filesystem::rename(tempFile, binaryFile, ec);
+    if (ec)
+    {
+        filesystem::remove(tempFile, ec);
+        logMessage(WARNING, "Cannot write precompiled map: " + binaryFile);
+        return false;
+    }
+
+    LOG_NOTIFY(INFO, "Precompiled map written: ", binaryFile);
+    return true;
+}
+
+// Reads the tables in place from the mapped file; returns nullptr if the file is
+// malformed or was built from a different source (the caller then parses the text)
+Map *MapLoader::loadBinaryMap(const string &binaryFile, uint64_t expectedSourceSize)
+{
+    MappedFile file(binaryFile);
+    if (!file.isOpen() || file.size() < sizeof(WzbHeader))
+        return nullptr;
+
+    WzbHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, WZB_MAGIC, sizeof(header.magic)) != 0 || header.version != WZB_VERSION ||
+        header.byteOrderMark != WZB_BYTE_ORDER_MARK || header.sourceSize != expectedSourceSize)
+        return nullptr;
+
+    uint64_t expectedSize = sizeof(WzbHeader) +
+                            uint64_t(header.territoryCount) * sizeof(WzbTerritory) +
+                            uint64_t(header.continentCount) * sizeof(WzbContinent) +
+                            (uint64_t(header.territoryCount) + 1) * sizeof(int32_t) +
+                            uint64_t(header.adjacencyCount) * sizeof(int32_t) +
+                            uint64_t(header.memberCount) * sizeof(int32_t) +
+                            header.stringBytes;
+    if (expectedSize != file.size())
+        return nullptr;
+
+    const char *cursor = file.data() + sizeof(WzbHeader);
+    const WzbTerritory *territoryTable = reinterpret_cast<const WzbTerritory *>(cursor);
+    cursor += header.territoryCount * sizeof(WzbTerritory);
+    const WzbContinent *continentTable = reinterpret_cast<const WzbContinent *>(cursor);
+    cursor += header.continentCount * sizeof(WzbContinent);
+    const int32_t *adjacencyOffsets = reinterpret_cast<const int32_t *>(cursor);
+    cursor += (header.territoryCount + 1) * sizeof(int32_t);
+    const int32_t *adjacencyIds = reinterpret_cast<const int32_t *>(cursor);
+    cursor += header.adjacencyCount * sizeof(int32_t);
+    const int32_t *continentMembers = reinterpret_cast<const int32_t *>(cursor);
+    cursor += header.memberCount * sizeof(int32_t);
+    const char *strings = cursor;
+
+    // Bounds checks so a corrupt file can never index outside the mapping
+    auto validName = [&](uint32_t offset, uint32_t length)
+    { return uint64_t(offset) + length <= header.stringBytes; };
+    int territoryCount = static_cast<int>(header.territoryCount);
+    int continentCount = static_cast<int>(header.continentCount);
+
+    if (adjacencyOffsets[0] != 0 || uint32_t(adjacencyOffsets[territoryCount]) != header.adjacencyCount)
+        return nullptr;
+    for (int i = 0; i < territoryCount; ++i)
+    {
+        const WzbTerritory &entry = territoryTable[i];
+        if (!validName(entry.nameOffset, entry.nameLength) || entry.continentId < 0 || entry.continentId >= continentCount ||
+            adjacencyOffsets[i + 1] < adjacencyOffsets[i])
+            return nullptr;
+    }
+    for (uint32_t i = 0; i < header.adjacencyCount; ++i)
+    {
+        if (adjacencyIds[i] < 0 || adjacencyIds[i] >= territoryCount)
+            return nullptr;
+    }
+    for (int i = 0; i < continentCount; ++i)
+    {
+        const WzbContinent &entry = continentTable[i];
+        if (!validName(entry.nameOffset, entry.nameLength) || uint64_t(entry.firstMember) + entry.memberCount > header.memberCount)
+            return nullptr;
+    }
+    for (uint32_t i = 0; i < header.memberCount; ++i)
+    {
+        if (continentMembers[i] < 0 || continentMembers[i] >= territoryCount)
+            return nullptr;
+    }
+
+    LOG_NOTIFY(INFO, "Loading precompiled map from: ", binaryFile);
+
+    Map *map = new Map();
+    for (int i = 0; i < continentCount; ++i)
+    {
+        const WzbContinent &entry = continentTable[i];
+        Continent continent(string(strings + entry.nameOffset, entry.nameLength), i, entry.bonusValue);
+        for (uint32_t m = 0; m < entry.memberCount; ++m)
+            continent.addTerritory(continentMembers[entry.firstMember + m]);
+        map->addContinent(continent);
+    }
+    for (int i = 0; i < territoryCount; ++i)
+    {
+        const WzbTerritory &entry = territoryTable[i];
+        map->addTerritory(Territory(string(strings + entry.nameOffset, entry.nameLength), i, entry.continentId, entry.x, entry.y));
+    }
+    map->adoptAdjacency(vector<int>(adjacencyOffsets, adjacencyOffsets + territoryCount + 1),
+                        vector<int>(adjacencyIds, adjacencyIds + header.adjacencyCount));
+
+    logMessage(INFO, "Map loaded successfully!");
+    map->printMapStatistics();
+    return map;
+}
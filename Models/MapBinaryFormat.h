@@ -0,0 +1,55 @@
+#ifndef MAP_BINARY_FORMAT_H
+#define MAP_BINARY_FORMAT_H
+
+#include <cstdint>
+#include <string>
+
+// Precompiled map format (.wzb), built from a Conquest .map and kept in the map cache
+// directory (MapLoader::binaryCacheDir).
+// All integers are stored in host byte order (checked through byteOrderMark).
+//
+//   WzbHeader
+//   WzbTerritory  territories[territoryCount]
+//   WzbContinent  continents[continentCount]
+//   int32_t       adjacencyOffsets[territoryCount + 1]   CSR row offsets
+//   int32_t       adjacencyIds[adjacencyCount]           CSR neighbor ids, sorted per territory
+//   int32_t       continentMembers[memberCount]          territory ids, grouped per continent
+//   char          strings[stringBytes]                   interned names (not NUL terminated)
+
+const char WZB_MAGIC[4] = {'W', 'Z', 'B', '1'};
+const uint32_t WZB_VERSION = 1;
+const uint32_t WZB_BYTE_ORDER_MARK = 0x01020304;
+const std::string WZB_EXTENSION = ".wzb";
+
+struct WzbHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t territoryCount;
+    uint32_t continentCount;
+    uint32_t adjacencyCount;
+    uint32_t memberCount;
+    uint32_t stringBytes;
+    uint64_t sourceSize; // size of the .map file this was compiled from
+};
+
+struct WzbTerritory
+{
+    uint32_t nameOffset; // into the string table
+    uint32_t nameLength;
+    int32_t continentId;
+    int32_t x;
+    int32_t y;
+};
+
+struct WzbContinent
+{
+    uint32_t nameOffset; // into the string table
+    uint32_t nameLength;
+    int32_t bonusValue;
+    uint32_t firstMember; // into continentMembers
+    uint32_t memberCount;
+};
+
+#endif
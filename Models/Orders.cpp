@@ -4,45 +4,293 @@
 #include "GameEngine.h"
 #include <random>
 #include <algorithm>
+#include <iterator>
 #include <string>
 #include "../utils/logger.h"
 
+// Combat kernels
+BattleResult resolveBattle(int attackers, int defenders, GameRng &rng)
+{
+    BattleResult result{std::max(0, attackers), std::max(0, defenders), 0};
+    while (result.attackers > 0 && result.defenders > 0)
+    {
+        // Both sides fire at the same time, so kills are drawn from the pre-round stacks
+        int aKills = std::binomial_distribution<int>(result.attackers, ATTACKER_HIT_CHANCE)(rng);
+        int dKills = std::binomial_distribution<int>(result.defenders, DEFENDER_HIT_CHANCE)(rng);
+        result.defenders = std::max(0, result.defenders - aKills);
+        result.attackers = std::max(0, result.attackers - dKills);
+        result.rounds++;
+    }
+    return result;
+}
+
+BattleResult resolveBattlePerArmy(int attackers, int defenders, GameRng &rng)
+{
+    std::bernoulli_distribution atkHit(ATTACKER_HIT_CHANCE), defHit(DEFENDER_HIT_CHANCE);
+    BattleResult result{std::max(0, attackers), std::max(0, defenders), 0};
+    while (result.attackers > 0 && result.defenders > 0)
+    {
+        int aKills = 0, dKills = 0;
+        for (int i = 0; i < result.attackers; ++i)
+            if (atkHit(rng))
+                aKills++;
+        for (int i = 0; i < result.defenders; ++i)
+            if (defHit(rng))
+                dKills++;
+        result.defenders = std::max(0, result.defenders - aKills);
+        result.attackers = std::max(0, result.attackers - dKills);
+        result.rounds++;
+    }
+    return result;
+}
+
+// Order rules
+bool orderIsValid(OrderKind kind, const OrderParams &params, const GameEngine *engine)
+{
+    Player *issuer = params.issuer;
+    Territory *source = params.source;
+    Territory *target = params.target;
+    switch (kind)
+    {
+    case OrderKind::Deploy:
+        if (!issuer || !target)
+            return false;
+        if (target->getOwner() != issuer)
+            return false;
+        return params.armies <= issuer->getReinforcementPool();
+    case OrderKind::Advance:
+        if (!issuer || !source || !target)
+            return false;
+        if (source->getOwner() != issuer)
+            return false; // source has to be yours
+        if (source->getArmies() <= 0)
+            return false;
+        return source->isAdjacentTo(target->getId());
+    case OrderKind::Bomb:
+    {
+        if (!issuer || !target)
+            return false;
+        if (target->getOwner() == issuer)
+            return false; // Cannot bomb own territory
+
+        // Must be adjacent to at least one of the issuer's territories
+        for (auto *myT : issuer->toDefend())
+        {
+            if (myT && myT->isAdjacentTo(target->getId()))
+                return true;
+        }
+        return false;
+    }
+    case OrderKind::Blockade:
+        if (!issuer || !target || !engine)
+            return false;
+        return target->getOwner() == issuer; // must be own territory
+    case OrderKind::Airlift:
+        if (!issuer || !source || !target)
+            return false;
+        return source->getOwner() == issuer && target->getOwner() == issuer;
+    case OrderKind::Negotiate:
+        if (!issuer || !params.other || !engine)
+            return false;
+        return issuer != params.other;
+    }
+    return false;
+}
+
+OrderOutcome applyOrder(OrderKind kind, const OrderParams &params, GameEngine *engine)
+{
+    OrderOutcome outcome;
+    Player *issuer = params.issuer;
+    Territory *source = params.source;
+    Territory *target = params.target;
+    outcome.source = source ? source->getId() : -1;
+    outcome.target = target ? target->getId() : -1;
+    if (!orderIsValid(kind, params, engine))
+    {
+        outcome.result = OrderResult::Invalid;
+        return outcome;
+    }
+
+    switch (kind)
+    {
+    case OrderKind::Deploy:
+        issuer->setReinforcementPool(issuer->getReinforcementPool() - params.armies);
+        target->addArmies(params.armies);
+        outcome.result = OrderResult::Deployed;
+        outcome.armies = params.armies;
+        break;
+    case OrderKind::Advance:
+    {
+        int src = source->getArmies();
+        int moved = std::max(0, std::min(params.armies, src));
+        source->setArmies(src - moved);
+        outcome.armies = moved;
+        if (target->getOwner() == issuer)
+        {
+            // friendly move
+            target->setArmies(target->getArmies() + moved);
+            outcome.result = OrderResult::Moved;
+            break;
+        }
+
+        // enemy: battle simulation 60% / 70%
+        outcome.result = OrderResult::Repelled;
+        BattleResult battle = resolveBattle(moved, target->getArmies(), currentGameRng());
+        outcome.attackersLeft = battle.attackers;
+        outcome.defendersLeft = battle.defenders;
+        target->setArmies(battle.defenders);
+        if (battle.defenders == 0 && battle.attackers > 0)
+        {
+            // capture territory; survivors occupy
+            // Update territory ownership in both Territory and Player lists
+            Player::transferTerritory(target, issuer);
+            target->setArmies(battle.attackers);
+            issuer->markConqueredThisTurn();
+            outcome.result = OrderResult::Conquered;
+        }
+        break;
+    }
+    case OrderKind::Bomb:
+        outcome.result = OrderResult::Bombed;
+        outcome.before = target->getArmies();
+        outcome.after = outcome.before / 2;
+        target->setArmies(outcome.after);
+        break;
+    case OrderKind::Blockade:
+        outcome.result = OrderResult::Blockaded;
+        outcome.before = target->getArmies();
+        outcome.after = outcome.before * 2;
+        target->setArmies(outcome.after);
+        Player::transferTerritory(target, engine->getNeutralPlayer());
+        break;
+    case OrderKind::Airlift:
+    {
+        int src = source->getArmies();
+        int moved = std::max(0, std::min(params.armies, src));
+        source->setArmies(src - moved);
+        target->setArmies(target->getArmies() + moved);
+        outcome.result = OrderResult::Airlifted;
+        outcome.armies = moved;
+        break;
+    }
+    case OrderKind::Negotiate:
+        outcome.result = OrderResult::Negotiated;
+        engine->addTruce(issuer, params.other); // store truce for rest of this turn
+        break;
+    }
+    return outcome;
+}
+
+static const char *invalidReason(OrderKind kind)
+{
+    switch (kind)
+    {
+    case OrderKind::Deploy:
+        return "Invalid: target not owned by issuer.";
+    case OrderKind::Advance:
+        return "Invalid: source not owned or not adjacent.";
+    case OrderKind::Bomb:
+        return "Invalid: target is not enemy or not adjacent to issuer territories.";
+    case OrderKind::Blockade:
+        return "Invalid: target must be owned by issuer.";
+    case OrderKind::Airlift:
+        return "Invalid: source/target must both be owned by issuer.";
+    case OrderKind::Negotiate:
+        return "Invalid: cannot negotiate with self.";
+    }
+    return "Invalid.";
+}
+
+std::string describeOutcome(OrderKind kind, const OrderParams &params, const OrderOutcome &outcome)
+{
+    using std::to_string;
+    switch (outcome.result)
+    {
+    case OrderResult::NotExecuted:
+        return "None";
+    case OrderResult::Invalid:
+        return invalidReason(kind);
+    case OrderResult::Deployed:
+        return "Deployed " + to_string(outcome.armies) + " to " + params.target->getName();
+    case OrderResult::Moved:
+        return "Moved " + to_string(outcome.armies) + " to defend " + params.target->getName();
+    case OrderResult::Conquered:
+        return "Conquered " + params.target->getName() + " with " + to_string(outcome.attackersLeft) + " survivors.";
+    case OrderResult::Repelled:
+        return "Attack ended. Defender left " + to_string(outcome.defendersLeft) + ", attackers left " +
+               to_string(outcome.attackersLeft) + ".";
+    case OrderResult::Bombed:
+        return "Bombed " + params.target->getName() + " from " + to_string(outcome.before) + " to " + to_string(outcome.after);
+    case OrderResult::Blockaded:
+        return "Blockade: doubled armies and transferred " + params.target->getName() + " to Neutral.";
+    case OrderResult::Airlifted:
+        return "Airlifted " + to_string(outcome.armies) + " from " + params.source->getName() + " to " +
+               params.target->getName();
+    case OrderResult::Negotiated:
+        return "Negotiation: attacks between players blocked for this turn.";
+    }
+    return "None";
+}
+
 //  Base Order
-Order::Order(Player *issuingPlayer) : description("Generic Order"), effect("None"), executed(false), issuer(issuingPlayer) {}
-Order::Order() : description("Generic Order"), effect("None"), executed(false), issuer(nullptr) {}
+Order::Order(Player *issuingPlayer) : description("Generic Order"), executed(false), issuer(issuingPlayer) {}
+Order::Order() : description("Generic Order"), executed(false), issuer(nullptr) {}
 
 Order::~Order() {}
 
-Order::Order(const Order &otherOrder) : description(otherOrder.description), effect(otherOrder.effect), executed(otherOrder.executed), issuer(otherOrder.issuer) {}
+Order::Order(const Order &otherOrder) : description(otherOrder.description), outcome(otherOrder.outcome), executed(otherOrder.executed), issuer(otherOrder.issuer), orderKind(otherOrder.orderKind) {}
 
 Order &Order::operator=(const Order &otherOrder)
 {
     if (this != &otherOrder)
     {
         description = otherOrder.description;
-        effect = otherOrder.effect;
+        outcome = otherOrder.outcome;
         executed = otherOrder.executed;
         issuer = otherOrder.issuer;
     }
     return *this;
 }
 
+Order *Order::create(OrderKind kind, const OrderParams &params, Map *map, GameEngine *engine)
+{
+    switch (kind)
+    {
+    case OrderKind::Deploy:
+        return new Deploy(params.issuer, params.target, params.armies);
+    case OrderKind::Advance:
+        return new Advance(params.issuer, params.source, params.target, params.armies);
+    case OrderKind::Bomb:
+        return new Bomb(params.issuer, params.target, map);
+    case OrderKind::Blockade:
+        return new Blockade(params.issuer, params.target, engine);
+    case OrderKind::Airlift:
+        return new Airlift(params.issuer, params.source, params.target, params.armies);
+    case OrderKind::Negotiate:
+        return new Negotiate(params.issuer, params.other, engine);
+    }
+    return nullptr;
+}
+
 std::ostream &operator<<(std::ostream &os, const Order &order)
 {
     os << order.description;
-    if (order.effect != "None")
+    if (order.outcome.result != OrderResult::NotExecuted)
     {
-        os << " | Effect: " << order.effect;
+        os << " | Effect: " << order.getEffect();
     }
     return os;
 }
+std::string Order::getEffect() const { return describeOutcome(orderKind, params(), outcome); }
+
 //  Deploy
 Deploy::Deploy()
 {
     description = "Deploy Order";
+    orderKind = OrderKind::Deploy;
 }
 Deploy::Deploy(Player *p, Territory *t, int a)
-    : issuer(p), target(t), armies(a) { description = "Deploy Order"; }
+    : issuer(p), target(t), armies(a) { description = "Deploy Order"; orderKind = OrderKind::Deploy; }
 Deploy::~Deploy() {}
 
 Deploy::Deploy(const Deploy &otherDeploy) : Order(otherDeploy), issuer(otherDeploy.issuer), target(otherDeploy.target), armies(otherDeploy.armies) {}
@@ -61,43 +309,22 @@ Deploy &Deploy::operator=(const Deploy &otherDeploy)
 
 Order *Deploy::clone() const { return new Deploy(*this); }
 
-bool Deploy::validate()
-{
-    if (!issuer || !target)
-        return false;
-    if (target->getOwner() != issuer)
-        return false;
-    if (armies > issuer->getReinforcementPool())
-        return false;
-    return true;
-}
+bool Deploy::validate() { return orderIsValid(OrderKind::Deploy, params(), nullptr); }
 void Deploy::execute()
 {
-    if (!validate())
+    outcome = applyOrder(OrderKind::Deploy, params(), nullptr);
+    if (!outcome.valid())
     {
-
-        effect = "Invalid: target not owned by issuer.";
-        Notify(this, DEBUG, "Invalid: target not owned by issuer.");
+        LOG_OBSERVERS(DEBUG, getEffect());
         return;
     }
-    if (issuer->getReinforcementPool() < armies)
-    {
-        effect = "Invalid: not enough reinforcement armies.";
-        Notify(this, DEBUG, "Invalid: not enough reinforcement armies.");
-        return;
-    }
-
-    issuer->setReinforcementPool(issuer->getReinforcementPool() - armies);
-    target->addArmies(armies);
-
-    effect = "Deployed " + std::to_string(armies) + " to " + target->getName();
     executed = true;
-    Notify(this, COMBAT, "Deployed " + std::to_string(armies) + " to " + target->getName());
+    LOG_OBSERVERS(COMBAT, getEffect());
 }
 
-Advance::Advance() { description = "Advance Order"; }
+Advance::Advance() { description = "Advance Order"; orderKind = OrderKind::Advance; }
 Advance::Advance(Player *p, Territory *s, Territory *t, int a)
-    : issuer(p), source(s), target(t), armies(a) { description = "Advance Order"; }
+    : issuer(p), source(s), target(t), armies(a) { description = "Advance Order"; orderKind = OrderKind::Advance; }
 Advance::~Advance() {}
 
 Advance::Advance(const Advance &otherAdvance) : Order(otherAdvance), issuer(otherAdvance.issuer), source(otherAdvance.source), target(otherAdvance.target), armies(otherAdvance.armies) {}
@@ -117,96 +344,27 @@ Advance &Advance::operator=(const Advance &otherAdvance)
 
 Order *Advance::clone() const { return new Advance(*this); }
 
-bool Advance::validate()
-{
-    if (!issuer || !source || !target)
-        return false;
-    if (source->getOwner() != issuer)
-        return false; // source has to be yours
-    if (source->getArmies() <= 0)
-        return false;
-    if (!source->isAdjacentTo(target->getId()))
-        return false;
-
-    return true;
-}
+bool Advance::validate() { return orderIsValid(OrderKind::Advance, params(), nullptr); }
 void Advance::execute()
 {
-    if (!validate())
+    outcome = applyOrder(OrderKind::Advance, params(), nullptr);
+    if (!outcome.valid())
     {
-        effect = "Invalid: source not owned or not adjacent.";
-        Notify(this, DEBUG, "Invalid: source not owned or not adjacent."); // Notify observers
+        LOG_OBSERVERS(DEBUG, getEffect()); // Notify observers
         return;
     }
-    if (target->getOwner() == issuer)
+    if (!outcome.battle())
     {
-        // friendly move
-        int src = source->getArmies();
-        int moved = std::max(0, std::min(armies, src));
-        source->setArmies(src - moved);
-        target->setArmies(target->getArmies() + moved);
-        effect = "Moved " + std::to_string(moved) + " to defend " + target->getName();
-        Notify(this, INFO, effect);
+        LOG_OBSERVERS(INFO, getEffect());
         return;
     }
-
-    // enemy: battle simulation 60% / 70%
-    int src = source->getArmies();
-    int atk = std::max(0, std::min(armies, src));
-    source->setArmies(src - atk);
-    int def = target->getArmies();
-
-    std::mt19937 rng(std::random_device{}());
-    std::bernoulli_distribution atkHit(0.6), defHit(0.7);
-
-    int a = atk, d = def;
-    while (a > 0 && d > 0)
-    {
-        int aKills = 0, dKills = 0;
-        for (int i = 0; i < a; ++i)
-            if (atkHit(rng))
-                aKills++;
-        for (int i = 0; i < d; ++i)
-            if (defHit(rng))
-                dKills++;
-        d = std::max(0, d - aKills);
-        a = std::max(0, a - dKills);
-    }
-
-    target->setArmies(d);
-    if (d == 0 && a > 0)
-    {
-        // capture territory; survivors occupy
-        Player *prevOwner = target->getOwner();
-
-        // Update territory ownership in both Territory and Player lists
-        if (prevOwner != nullptr)
-        {
-            prevOwner->removeTerritory(target);
-        }
-        target->setOwner(issuer);
-
-        // Only add if not already in issuer's list (shouldn't happen, but safety check)
-        if (!issuer->ownsTerritoryId(target->getId()))
-        {
-            issuer->addTerritory(target);
-        }
-        target->setArmies(a);
-
-        issuer->markConqueredThisTurn();
-        effect = "Conquered " + target->getName() + " with " + std::to_string(a) + " survivors.";
-    }
-    else
-    {
-        effect = "Attack ended. Defender left " + std::to_string(d) + ", attackers left " + std::to_string(a) + ".";
-    }
     executed = true;
-    Notify(this, PROGRESSION, effect); // Notify Observers
+    LOG_OBSERVERS(PROGRESSION, getEffect()); // Notify Observers
 }
 
-Bomb::Bomb() { description = "Bomb Order"; }
+Bomb::Bomb() { description = "Bomb Order"; orderKind = OrderKind::Bomb; }
 Bomb::Bomb(Player *p, Territory *t, Map *m)
-    : issuer(p), target(t), map(m) { description = "Bomb Order"; }
+    : issuer(p), target(t), map(m) { description = "Bomb Order"; orderKind = OrderKind::Bomb; }
 Bomb::~Bomb() {}
 
 Bomb::Bomb(const Bomb &otherBomb) : Order(otherBomb), issuer(otherBomb.issuer), target(otherBomb.target), map(otherBomb.map) {}
@@ -225,45 +383,22 @@ Bomb &Bomb::operator=(const Bomb &otherBomb)
 
 Order *Bomb::clone() const { return new Bomb(*this); }
 
-bool Bomb::validate()
-{
-    if (!issuer || !target)
-        return false;
-
-    if (target->getOwner() == issuer)
-        return false; // Cannot bomb own territory
-
-    // Must be adjacent to at least one of the issuer's territories
-    bool adjacent = false;
-    for (auto *myT : issuer->toDefend())
-    {
-        if (myT && myT->isAdjacentTo(target->getId()))
-        {
-            adjacent = true;
-            break;
-        }
-    }
-    return adjacent;
-}
+bool Bomb::validate() { return orderIsValid(OrderKind::Bomb, params(), nullptr); }
 void Bomb::execute()
 {
-    if (!validate())
+    outcome = applyOrder(OrderKind::Bomb, params(), nullptr);
+    if (!outcome.valid())
     {
-        effect = "Invalid: target is not enemy or not adjacent to issuer territories.";
-        Notify(this, DEBUG, effect);
+        LOG_OBSERVERS(DEBUG, getEffect());
         return;
     }
-    int before = target->getArmies();
-    int after = before / 2;
-    target->setArmies(after);
-    effect = "Bombed " + target->getName() + " from " + std::to_string(before) + " to " + std::to_string(after);
     executed = true;
-    Notify(this, COMBAT, effect);
+    LOG_OBSERVERS(COMBAT, getEffect());
 }
 
-Blockade::Blockade() { description = "Blockade Order"; }
+Blockade::Blockade() { description = "Blockade Order"; orderKind = OrderKind::Blockade; }
 Blockade::Blockade(Player *p, Territory *t, GameEngine *eng)
-    : issuer(p), target(t), engine(eng) { description = "Blockade Order"; }
+    : issuer(p), target(t), engine(eng) { description = "Blockade Order"; orderKind = OrderKind::Blockade; }
 Blockade::~Blockade() {}
 
 Blockade::Blockade(const Blockade &otherBlockade) : Order(otherBlockade), issuer(otherBlockade.issuer), target(otherBlockade.target), engine(otherBlockade.engine) {}
@@ -282,32 +417,23 @@ Blockade &Blockade::operator=(const Blockade &otherBlockade)
 
 Order *Blockade::clone() const { return new Blockade(*this); }
 
-bool Blockade::validate()
-{
-    if (!issuer || !target || !engine)
-        return false;
-    return target->getOwner() == issuer; // must be own territory
-}
+bool Blockade::validate() { return orderIsValid(OrderKind::Blockade, params(), engine); }
 
 void Blockade::execute()
 {
-    if (!validate())
+    outcome = applyOrder(OrderKind::Blockade, params(), engine);
+    if (!outcome.valid())
     {
-        effect = "Invalid: target must be owned by issuer.";
-        Notify(this, DEBUG, effect);
+        LOG_OBSERVERS(DEBUG, getEffect());
         return;
     }
-    target->setArmies(target->getArmies() * 2);
-    Player *neutral = engine->getNeutralPlayer();
-    target->setOwner(neutral);
-    effect = "Blockade: doubled armies and transferred " + target->getName() + " to Neutral.";
     executed = true;
-    Notify(this, COMBAT, effect); // Notify Observers
+    LOG_OBSERVERS(COMBAT, getEffect()); // Notify Observers
 }
 
-Airlift::Airlift() { description = "Airlift Order"; }
+Airlift::Airlift() { description = "Airlift Order"; orderKind = OrderKind::Airlift; }
 Airlift::Airlift(Player *p, Territory *s, Territory *t, int a)
-    : issuer(p), source(s), target(t), armies(a) { description = "Airlift Order"; }
+    : issuer(p), source(s), target(t), armies(a) { description = "Airlift Order"; orderKind = OrderKind::Airlift; }
 Airlift::~Airlift() {}
 
 Airlift::Airlift(const Airlift &otherAirlift) : Order(otherAirlift), issuer(otherAirlift.issuer), source(otherAirlift.source), target(otherAirlift.target), armies(otherAirlift.armies) {}
@@ -326,32 +452,22 @@ Airlift &Airlift::operator=(const Airlift &otherAirlift)
 
 Order *Airlift::clone() const { return new Airlift(*this); }
 
-bool Airlift::validate()
-{
-    if (!issuer || !source || !target)
-        return false;
-    return source->getOwner() == issuer && target->getOwner() == issuer;
-}
+bool Airlift::validate() { return orderIsValid(OrderKind::Airlift, params(), nullptr); }
 void Airlift::execute()
 {
-    if (!validate())
+    outcome = applyOrder(OrderKind::Airlift, params(), nullptr);
+    if (!outcome.valid())
     {
-        effect = "Invalid: source/target must both be owned by issuer.";
-        Notify(this, DEBUG, effect); // Notify Observers
+        LOG_OBSERVERS(DEBUG, getEffect()); // Notify Observers
         return;
     }
-    int src = source->getArmies();
-    int moved = std::max(0, std::min(armies, src));
-    source->setArmies(src - moved);
-    target->setArmies(target->getArmies() + moved);
-    effect = "Airlifted " + std::to_string(moved) + " from " + source->getName() + " to " + target->getName();
     executed = true;
-    Notify(this, COMBAT, effect);
+    LOG_OBSERVERS(COMBAT, getEffect());
 }
 
-Negotiate::Negotiate() { description = "Negotiate Order"; }
+Negotiate::Negotiate() { description = "Negotiate Order"; orderKind = OrderKind::Negotiate; }
 Negotiate::Negotiate(Player *p, Player *o, GameEngine *eng)
-    : issuer(p), other(o), engine(eng) { description = "Negotiate (Diplomacy) Order"; }
+    : issuer(p), other(o), engine(eng) { description = "Negotiate (Diplomacy) Order"; orderKind = OrderKind::Negotiate; }
 Negotiate::~Negotiate() {}
 
 Negotiate::Negotiate(const Negotiate &otherNegotiate) : Order(otherNegotiate), issuer(otherNegotiate.issuer), other(otherNegotiate.other), engine(otherNegotiate.engine) {}
@@ -370,24 +486,17 @@ Negotiate &Negotiate::operator=(const Negotiate &otherNegotiate)
 
 Order *Negotiate::clone() const { return new Negotiate(*this); }
 
-bool Negotiate::validate()
-{
-    if (!issuer || !other || !engine)
-        return false;
-    return issuer != other;
-}
+bool Negotiate::validate() { return orderIsValid(OrderKind::Negotiate, params(), engine); }
 void Negotiate::execute()
 {
-    if (!validate())
+    outcome = applyOrder(OrderKind::Negotiate, params(), engine);
+    if (!outcome.valid())
     {
-        effect = "Invalid: cannot negotiate with self.";
-        Notify(this, DEBUG, effect);
+        LOG_OBSERVERS(DEBUG, getEffect());
         return;
     }
-    engine->addTruce(issuer, other); // store truce for rest of this turn
-    effect = "Negotiation: attacks between players blocked for this turn.";
     executed = true;
-    Notify(this, INFO, effect);
+    LOG_OBSERVERS(INFO, getEffect());
 }
 
 //  OrdersList
@@ -395,18 +504,16 @@ OrdersList::OrdersList() {}
 
 OrdersList::~OrdersList()
 {
-    for (auto o : orders)
-    {
-        delete o;
-    }
+    clear();
 }
 
 // Copy constructor
 OrdersList::OrdersList(const OrdersList &other)
 {
-    orders.reserve(other.orders.size());
-    for (Order *o : other.orders)
-        orders.push_back(o ? o->clone() : nullptr);
+    vector<Entry> entries = other.inIssueOrder();
+    for (Entry &entry : entries)
+        entry.order = entry.order->clone();
+    rebuild(entries);
 }
 
 // Assignment operator
@@ -414,74 +521,140 @@ OrdersList &OrdersList::operator=(const OrdersList &other)
 {
     if (this != &other)
     {
-        for (auto *o : orders)
-            delete o;
-        orders.clear();
-        orders.reserve(other.orders.size());
-        for (Order *o : other.orders)
-            orders.push_back(o ? o->clone() : nullptr);
+        clear();
+        vector<Entry> entries = other.inIssueOrder();
+        for (Entry &entry : entries)
+            entry.order = entry.order->clone();
+        rebuild(entries);
     }
     return *this;
 }
 
 void OrdersList::clear()
 {
-    for (auto *o : orders)
-    {
-        delete o;
-    }
-    orders.clear();
+    for (const Entry &entry : deployQueue)
+        delete entry.order;
+    for (const Entry &entry : otherQueue)
+        delete entry.order;
+    deployQueue.clear();
+    otherQueue.clear();
+    nextSequence = 0;
+}
+
+deque<OrdersList::Entry> &OrdersList::queueFor(const Order *order)
+{
+    return order->kind() == OrderKind::Deploy ? deployQueue : otherQueue;
+}
+
+// Merges both queues back into one list by sequence number
+vector<OrdersList::Entry> OrdersList::inIssueOrder() const
+{
+    vector<Entry> entries;
+    entries.reserve(deployQueue.size() + otherQueue.size());
+    merge(deployQueue.begin(), deployQueue.end(), otherQueue.begin(), otherQueue.end(), back_inserter(entries),
+          [](const Entry &a, const Entry &b)
+          { return a.sequence < b.sequence; });
+    return entries;
+}
+
+void OrdersList::rebuild(const vector<Entry> &entries)
+{
+    deployQueue.clear();
+    otherQueue.clear();
+    nextSequence = 0;
+    for (const Entry &entry : entries)
+        queueFor(entry.order).push_back(Entry{entry.order, nextSequence++});
 }
 
 void OrdersList::add(Order *order)
 {
     if (order != nullptr)
     {
-        orders.push_back(order);
+        queueFor(order).push_back(Entry{order, nextSequence++});
         string effect = "New order added to the list";
-        Notify(this, INFO, effect); // Notify observer
+        LOG_OBSERVERS(INFO, effect); // Notify observer
     }
 }
 
 void OrdersList::print() const
 {
-    for (size_t i = 0; i < orders.size(); i++)
+    vector<Entry> entries = inIssueOrder();
+    for (size_t i = 0; i < entries.size(); i++)
     {
-        std::cout << i << ": " << *orders[i] << std::endl;
+        std::cout << i << ": " << *entries[i].order << std::endl;
     }
 }
 void OrdersList::remove(int index)
 {
-    if (index >= 0 && index < (int)orders.size())
+    if (index >= 0 && index < (int)size())
     {
-        delete orders[index];
-        orders.erase(orders.begin() + index);
+        Entry target = inIssueOrder()[index];
+        deque<Entry> &queue = queueFor(target.order);
+        for (auto it = queue.begin(); it != queue.end(); ++it)
+        {
+            if (it->sequence == target.sequence)
+            {
+                queue.erase(it);
+                break;
+            }
+        }
+        delete target.order;
     }
 }
 
 void OrdersList::move(int fromIndex, int toIndex)
 {
-    if (fromIndex >= 0 && fromIndex < (int)orders.size() &&
-        toIndex >= 0 && toIndex < (int)orders.size())
+    if (fromIndex >= 0 && fromIndex < (int)size() &&
+        toIndex >= 0 && toIndex < (int)size())
+    {
+        vector<Entry> entries = inIssueOrder();
+        Entry temp = entries[fromIndex];
+        entries.erase(entries.begin() + fromIndex);
+        entries.insert(entries.begin() + toIndex, temp);
+        rebuild(entries);
+    }
+}
+
+void OrdersList::popDeploy()
+{
+    if (!deployQueue.empty())
     {
-        Order *temp = orders[fromIndex];
-        orders.erase(orders.begin() + fromIndex);
-        orders.insert(orders.begin() + toIndex, temp);
+        delete deployQueue.front().order;
+        deployQueue.pop_front();
     }
 }
+
+void OrdersList::popOther()
+{
+    if (!otherQueue.empty())
+    {
+        delete otherQueue.front().order;
+        otherQueue.pop_front();
+    }
+}
+
 size_t OrdersList::size() const
 {
-    return orders.size();
+    return deployQueue.size() + otherQueue.size();
 }
 
 OrdersList &OrdersList::getOrders() { return *this; }
 const OrdersList &OrdersList::getOrders() const { return *this; }
 
+vector<Order *> OrdersList::inOrder() const
+{
+    vector<Order *> orders;
+    orders.reserve(size());
+    for (const Entry &entry : inIssueOrder())
+        orders.push_back(entry.order);
+    return orders;
+}
+
 Order *OrdersList::get(int index) const
 {
-    if (index >= 0 && index < (int)orders.size())
+    if (index >= 0 && index < (int)size())
     {
-        return orders[index];
+        return inIssueOrder()[index].order;
     }
     return nullptr;
 }
@@ -1,9 +1,13 @@
 #ifndef ORDERS_H
 #define ORDERS_H
 
+#include <cstdint>
+#include <deque>
 #include <iostream>
 #include <string>
 #include <vector>
+#include "../utils/FreeListPool.h"
+#include "../utils/GameRng.h"
 #include "../utils/LoggingObserver.h"
 
 class GameEngine;
@@ -11,10 +15,89 @@ class Player;
 class Territory;
 class Map;
 
+// Battle odds: each attacking army kills a defender with 60%, each defending army an attacker with 70%
+const double ATTACKER_HIT_CHANCE = 0.6;
+const double DEFENDER_HIT_CHANCE = 0.7;
+
+struct BattleResult
+{
+    int attackers; // surviving attackers
+    int defenders; // surviving defenders
+    int rounds;
+};
+
+// Fights rounds until one side is wiped out. Kills per round are drawn from a binomial
+// distribution, so a round costs O(1) whatever the stack sizes.
+BattleResult resolveBattle(int attackers, int defenders, GameRng &rng);
+// Same battle with one Bernoulli draw per army per round; kept as the reference for testing
+BattleResult resolveBattlePerArmy(int attackers, int defenders, GameRng &rng);
+
+// Concrete order type, so callers can tell orders apart without RTTI
+enum class OrderKind : uint8_t
+{
+    Deploy,
+    Advance,
+    Bomb,
+    Blockade,
+    Airlift,
+    Negotiate
+};
+
+// What an order acts on; with its kind this is enough to rebuild it (game snapshots keep these)
+struct OrderParams
+{
+    Player *issuer = nullptr;
+    Territory *source = nullptr;
+    Territory *target = nullptr;
+    Player *other = nullptr; // Negotiate only
+    int armies = 0;
+};
+
+// How an order turned out when it ran
+enum class OrderResult : uint8_t
+{
+    NotExecuted,
+    Invalid,
+    Deployed,
+    Moved,     // Advance into the issuer's own territory
+    Conquered, // Advance: the battle took the territory
+    Repelled,  // Advance: the battle left the defender in place
+    Bombed,
+    Blockaded,
+    Airlifted,
+    Negotiated
+};
+
+// What executing an order did to the game, as plain numbers. Orders keep it as their
+// effect and turn it into text only when asked (getEffect, a log line someone takes).
+struct OrderOutcome
+{
+    OrderResult result = OrderResult::NotExecuted;
+    int32_t source = -1; // territory ids, -1 if the order has none
+    int32_t target = -1;
+    int armies = 0; // deployed, moved or airlifted; for an attack, the armies sent
+    int attackersLeft = 0;
+    int defendersLeft = 0;
+    int before = 0; // Bomb and Blockade: target armies before and after
+    int after = 0;
+
+    bool valid() const { return result != OrderResult::NotExecuted && result != OrderResult::Invalid; }
+    bool battle() const { return result == OrderResult::Conquered || result == OrderResult::Repelled; }
+};
+
+// The rules of every order, on plain pointers, so anything holding an order's kind and
+// parameters (an Order, a CompactOrder through its OrderContext) checks and changes the
+// game the same way. Blockade and Negotiate need the engine; the other kinds ignore it.
+bool orderIsValid(OrderKind kind, const OrderParams &params, const GameEngine *engine);
+OrderOutcome applyOrder(OrderKind kind, const OrderParams &params, GameEngine *engine); // Invalid: nothing changed
+// The effect text of an outcome, e.g. "Conquered Calgary with 3 survivors."
+std::string describeOutcome(OrderKind kind, const OrderParams &params, const OrderOutcome &outcome);
+
 // base Order
 class Order : public Subject, public ILoggable
 {
 public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_ORDER; }
     // Constructor
     Order(Player *issuingPlayer);
     Order();
@@ -28,8 +111,20 @@ public:
     virtual bool validate() = 0;
     virtual void execute() = 0;
     virtual Order *clone() const = 0;
+    virtual OrderParams params() const = 0;
+
+    // Every order (new, clone, create) takes its memory from the per-thread pool, and
+    // deleting it (OrdersList::remove, pop, clear) hands the block back for the next one
+    USE_FREE_LIST_POOL
 
-    std::string getEffect() const { return effect; }
+    // Plain field, set by each subclass: dispatch on it costs no virtual call
+    OrderKind kind() const { return orderKind; }
+
+    // Builds an order from its kind and parameters. Bomb keeps the map, Blockade and Negotiate the engine.
+    static Order *create(OrderKind kind, const OrderParams &params, Map *map, GameEngine *engine);
+
+    std::string getEffect() const; // rendered from the outcome on each call
+    const OrderOutcome &getOutcome() const { return outcome; }
     bool isExecuted() const { return executed; }
     Player *getIssuer() const { return issuer; }
 
@@ -37,14 +132,15 @@ public:
     friend std::ostream &operator<<(std::ostream &os, const Order &order);
 
 protected:
-    std::string description;
-    std::string effect;
+    const char *description; // fixed label per kind, so building an order copies no text
+    OrderOutcome outcome; // NotExecuted until execute() runs
     bool executed;
     Player *issuer;
+    OrderKind orderKind = OrderKind::Deploy;
 };
 
 // Order Subclasses
-class Deploy : public Order
+class Deploy final : public Order
 {
 public:
     Deploy(Player *issuer, Territory *target, int armies);
@@ -55,6 +151,7 @@ public:
     bool validate() override;
     void execute() override;
     Order *clone() const override;
+    OrderParams params() const override { return {issuer, nullptr, target, nullptr, armies}; }
 
 private:
     Player *issuer = nullptr;
@@ -62,7 +159,7 @@ private:
     int armies = 0;
 };
 
-class Advance : public Order
+class Advance final : public Order
 {
 public:
     Advance(Player *issuer, Territory *source, Territory *target, int armies);
@@ -73,6 +170,7 @@ public:
     bool validate() override;
     void execute() override;
     Order *clone() const override;
+    OrderParams params() const override { return {issuer, source, target, nullptr, armies}; }
 
 private:
     Player *issuer = nullptr;
@@ -81,7 +179,7 @@ private:
     int armies = 0;
 };
 
-class Bomb : public Order
+class Bomb final : public Order
 {
 public:
     Bomb(Player *issuer, Territory *target, Map *map);
@@ -92,6 +190,7 @@ public:
     bool validate() override;
     void execute() override;
     Order *clone() const override;
+    OrderParams params() const override { return {issuer, nullptr, target, nullptr, 0}; }
 
 private:
     Player *issuer = nullptr;
@@ -99,7 +198,7 @@ private:
     Map *map = nullptr;
 };
 
-class Blockade : public Order
+class Blockade final : public Order
 {
 public:
     Blockade(Player *issuer, Territory *target, GameEngine *engine);
@@ -110,6 +209,7 @@ public:
     bool validate() override;
     void execute() override;
     Order *clone() const override;
+    OrderParams params() const override { return {issuer, nullptr, target, nullptr, 0}; }
 
 private:
     Player *issuer = nullptr;
@@ -117,7 +217,7 @@ private:
     GameEngine *engine = nullptr;
 };
 
-class Airlift : public Order
+class Airlift final : public Order
 {
 public:
     Airlift(Player *issuer, Territory *source, Territory *target, int armies);
@@ -128,6 +228,7 @@ public:
     bool validate() override;
     void execute() override;
     Order *clone() const override;
+    OrderParams params() const override { return {issuer, source, target, nullptr, armies}; }
 
 private:
     Player *issuer = nullptr;
@@ -136,7 +237,7 @@ private:
     int armies = 0;
 };
 
-class Negotiate : public Order
+class Negotiate final : public Order
 {
 public:
     Negotiate(Player *issuer, Player *other, GameEngine *engine);
@@ -147,6 +248,7 @@ public:
     bool validate() override;
     void execute() override;
     Order *clone() const override;
+    OrderParams params() const override { return {issuer, nullptr, nullptr, other, 0}; }
 
 private:
     Player *issuer = nullptr;
@@ -155,10 +257,27 @@ private:
 };
 
 // OrdersList
+// Deploy orders and all other orders are kept in two FIFO queues, so the
+// execution phase pops the next order of either kind in O(1). The indexed
+// operations (get, remove, move, print) still see one list in issue order.
 class OrdersList : public Subject, public ILoggable
 {
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_ORDER; }
+
 private:
-    std::vector<Order *> orders;
+    struct Entry
+    {
+        Order *order;
+        uint64_t sequence; // position in issue order across both queues
+    };
+    std::deque<Entry> deployQueue;
+    std::deque<Entry> otherQueue;
+    uint64_t nextSequence = 0;
+
+    std::deque<Entry> &queueFor(const Order *order);
+    std::vector<Entry> inIssueOrder() const;
+    void rebuild(const std::vector<Entry> &entries); // refills both queues from entries, renumbered
 
 public:
     OrdersList();
@@ -181,6 +300,29 @@ public:
 
     size_t size() const;
     Order *get(int index) const;
+    std::vector<Order *> inOrder() const; // every order, in issue order
+
+    // Calls visit(order) for every order in issue order, walking both queues without a copy
+    template <typename Visit>
+    void forEachInOrder(Visit visit) const
+    {
+        auto deploy = deployQueue.begin();
+        auto other = otherQueue.begin();
+        while (deploy != deployQueue.end() || other != otherQueue.end())
+        {
+            if (other == otherQueue.end() || (deploy != deployQueue.end() && deploy->sequence < other->sequence))
+                visit((deploy++)->order);
+            else
+                visit((other++)->order);
+        }
+    }
+
+    // Execution phase: next order of each kind in issue order (nullptr if none),
+    // and removal (with delete) of that order
+    Order *nextDeploy() const { return deployQueue.empty() ? nullptr : deployQueue.front().order; }
+    Order *nextOther() const { return otherQueue.empty() ? nullptr : otherQueue.front().order; }
+    void popDeploy();
+    void popOther();
 };
 
 #endif // ORDERS_H
@@ -5,6 +5,7 @@
 #include "Orders.h"
 #include "Cards.h"
 #include "Map.h"
+#include "GameRecord.h"
 #include "../utils/logger.h"
 using namespace std;
 
@@ -41,6 +42,7 @@ Player::Player(const Player &other)
 {
     playerName = other.playerName;
     reinforcementPool = other.reinforcementPool;
+    ownedIds = other.ownedIds;
 
     // Deep copy territories
     for (auto *territory : other.territories)
@@ -54,7 +56,7 @@ Player::Player(const Player &other)
     // Deep copy OrdersList
     orders = new OrdersList(*other.orders);
 
-    logMessage(DEBUG, "Player copied.");
+    LOG_MESSAGE(DEBUG, "Player copied.");
 }
 
 // Assignment operator
@@ -72,6 +74,7 @@ Player &Player::operator=(const Player &other)
         {
             territories.push_back(new Territory(*territory)); // Deep copy each territory
         }
+        ownedIds = other.ownedIds;
 
         // Deep copy handOfCards
         if (handOfCards)
@@ -86,7 +89,7 @@ Player &Player::operator=(const Player &other)
         playerName = other.playerName;
         reinforcementPool = other.reinforcementPool;
     }
-    logMessage(DEBUG, "Player assigned.");
+    LOG_MESSAGE(DEBUG, "Player assigned.");
     return *this;
 }
 
@@ -118,12 +121,90 @@ void Player::addToReinforcement(int n) { reinforcementPool += std::max(0, n); }
 
 bool Player::ownsTerritoryId(int tid) const
 {
-    for (const Territory *t : territories)
+    if (tid < 0)
+        return false;
+    size_t word = static_cast<size_t>(tid) / 64;
+    return word < ownedIds.size() && (ownedIds[word] >> (tid % 64)) & 1;
+}
+
+void Player::setOwnedBit(int tid, bool owned)
+{
+    if (tid < 0)
+        return;
+    size_t word = static_cast<size_t>(tid) / 64;
+    if (word >= ownedIds.size())
     {
-        if (t && t->getId() == tid)
-            return true;
+        if (!owned)
+            return;
+        ownedIds.resize(word + 1, 0);
+    }
+    uint64_t mask = uint64_t(1) << (tid % 64);
+    if (owned)
+        ownedIds[word] |= mask;
+    else
+        ownedIds[word] &= ~mask;
+}
+
+void Player::addTerritory(Territory *territory)
+{
+    if (!territory || ownsTerritoryId(territory->getId()))
+        return;
+    territory->setOwnerSlot(static_cast<int>(territories.size()));
+    territories.push_back(territory);
+    setOwnedBit(territory->getId(), true);
+}
+
+void Player::removeTerritory(Territory *territory)
+{
+    if (!territory || !ownsTerritoryId(territory->getId()))
+        return;
+
+    int slot = territory->getOwnerSlot();
+    if (slot < 0 || slot >= static_cast<int>(territories.size()) || territories[slot] != territory)
+    {
+        // Stale slot (the territory was also listed by another player): find it the slow way
+        auto it = std::find(territories.begin(), territories.end(), territory);
+        if (it == territories.end())
+            return;
+        slot = static_cast<int>(it - territories.begin());
+    }
+
+    Territory *last = territories.back();
+    territories[slot] = last;
+    last->setOwnerSlot(slot);
+    territories.pop_back();
+    territory->setOwnerSlot(-1);
+    setOwnedBit(territory->getId(), false);
+}
+
+void Player::clearTerritories()
+{
+    for (Territory *territory : territories)
+        territory->setOwnerSlot(-1);
+    territories.clear();
+    std::fill(ownedIds.begin(), ownedIds.end(), 0);
+}
+
+void Player::transferTerritory(Territory *territory, Player *newOwner)
+{
+    if (!territory)
+        return;
+    Player *oldOwner = territory->getOwner();
+    if (oldOwner && oldOwner != newOwner)
+        oldOwner->removeTerritory(territory);
+    if (oldOwner != newOwner)
+    {
+        if (Continent *continent = territory->getContinent())
+        {
+            continent->adjustOwnerCount(oldOwner, -1);
+            continent->adjustOwnerCount(newOwner, 1);
+        }
     }
-    return false;
+    territory->setOwner(newOwner);
+    if (newOwner)
+        newOwner->addTerritory(territory);
+    if (GameRecorder *recorder = activeRecorder())
+        recorder->ownerChanged(territory, newOwner);
 }
 
 void Player::setStrategy(PlayerStrategy *newStrategy)
@@ -137,13 +218,11 @@ void Player::setStrategy(PlayerStrategy *newStrategy)
 
     if (dynamic_cast<HumanPlayerStrategy *>(newStrategy) != nullptr)
     {
-        logMessage(HUMAN, playerName + " strategy set to " + strategy->getStrategyName());
-        Notify(this, HUMAN, playerName + " strategy set to " + strategy->getStrategyName());
+        LOG_NOTIFY(HUMAN, playerName, " strategy set to ", strategy->getStrategyName());
     }
     else
     {
-        logMessage(AI, playerName + " strategy set to " + strategy->getStrategyName());
-        Notify(this, AI, playerName + " strategy set to " + strategy->getStrategyName());
+        LOG_NOTIFY(AI, playerName, " strategy set to ", strategy->getStrategyName());
     }
 }
 
@@ -229,8 +308,7 @@ bool Player::issueOrder(Map *map, Deck *deck)
     {
         return strategy->issueOrder(this, map, deck);
     }
-    logMessage(ERROR, "strategy -> nullptr for issueOrder()");
-    Notify(this, ERROR, "strategy -> nullptr for issueOrder()");
+    LOG_NOTIFY(ERROR, "strategy -> nullptr for issueOrder()");
     return false; // fallback
 
     /*
@@ -5,15 +5,18 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <cstdint>
 #include "Map.h"
 #include "Orders.h"
 #include "Cards.h"
 #include "../PlayerStrategies/PlayerStrategies.h"
 #include "../utils/LoggingObserver.h"
+#include "../utils/Span.h"
 
 class Player : public Subject, public ILoggable
 {
 public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_PLAYER; }
     // Constructor
     Player(const std::string &playerName);
 
@@ -29,24 +32,23 @@ public:
     int getId() const;
     void setId(int pid);
 
-    void addTerritory(Territory *territory)
-    {
-        territories.push_back(territory);
-    }
-    void removeTerritory(Territory *territory)
-    {
-        territories.erase(
-            std::remove(territories.begin(), territories.end(), territory),
-            territories.end());
-    }
-    std::vector<Territory *> getTerritories() const { return territories; }
+    // Territory list maintenance, O(1): the territory keeps its slot in the list
+    // and removal swaps the last entry into it. Ownership itself is not touched.
+    void addTerritory(Territory *territory);
+    void removeTerritory(Territory *territory);
+    // Single ownership-transfer point: removes the territory from its current owner's
+    // list, sets the new owner and adds it to that owner's list. newOwner may be nullptr.
+    static void transferTerritory(Territory *territory, Player *newOwner);
+    // Empties the list without touching the territories' owners (snapshot restore refills it)
+    void clearTerritories();
+    Span<Territory *> getTerritories() const { return territories; } // view, no copy
     int takeFromReinforcement(int n); // for Deploy
     void addToReinforcement(int n);
     void markConqueredThisTurn() { conqueredThisTurn = true; }
     bool hasConqueredThisTurn() const { return conqueredThisTurn; }
     void resetConqueredFlag() { conqueredThisTurn = false; }
 
-    bool ownsTerritoryId(int tid) const;
+    bool ownsTerritoryId(int tid) const; // O(1), backed by ownedIds
     // getter
     std::string getPlayerName() const;
 
@@ -75,6 +77,8 @@ private:
     int id = -1;
     int reinforcementPool = 0;
     std::vector<Territory *> territories; // List of territories owned by the player (as pointers)
+    std::vector<uint64_t> ownedIds;       // Bitset over territory ids, kept in sync with territories
+    void setOwnedBit(int tid, bool owned);
     Hand *handOfCards;                    // List of cards owned by the player
     OrdersList *orders;                   // List of orders issued by the player (as pointer)
     bool conqueredThisTurn = false;
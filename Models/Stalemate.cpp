@@ -0,0 +1,79 @@
+#include "Stalemate.h"
+#include "GameEngine.h"
+#include "Map.h"
+#include "../utils/logger.h"
+
+using namespace std;
+
+uint64_t StalemateDetector::territoryKey(int id, int owner, int armies)
+{
+    // splitmix64 finalizer over the packed triple
+    uint64_t x = (static_cast<uint64_t>(static_cast<uint32_t>(id)) << 40) ^
+                 (static_cast<uint64_t>(static_cast<uint16_t>(owner)) << 24) ^ static_cast<uint32_t>(armies);
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+bool StalemateDetector::endTurn(const GameEngine &engine, int turn)
+{
+    if (!rule.enabled())
+        return false;
+    Map *map = engine.getMap();
+    int territoryCount = map ? map->getTerritoriesSize() : 0;
+
+    // An elimination renumbers the slots, and no earlier position can come back anyway
+    // (the eliminated player held territory in every one of them)
+    int players = static_cast<int>(engine.getPlayers().size());
+    if (players != playerCount)
+    {
+        seen.clear();
+        playerCount = players;
+    }
+
+    bool ownersChanged = false;
+    if (static_cast<int>(owners.size()) != territoryCount)
+    {
+        // First turn: hash everything
+        owners.assign(territoryCount, static_cast<int>(GameSnapshot::NO_PLAYER));
+        armies.assign(territoryCount, 0);
+        positionHash = 0;
+        for (int id = 0; id < territoryCount; id++)
+        {
+            Territory *territory = map->getTerritoryById(id);
+            owners[id] = engine.slotOf(territory->getOwner());
+            armies[id] = territory->getArmies();
+            positionHash ^= territoryKey(id, owners[id], armies[id]);
+        }
+        ownersChanged = true;
+    }
+    else
+    {
+        for (int id = 0; id < territoryCount; id++)
+        {
+            Territory *territory = map->getTerritoryById(id);
+            int owner = engine.slotOf(territory->getOwner());
+            int count = territory->getArmies();
+            if (owner == owners[id] && count == armies[id])
+                continue;
+            ownersChanged = ownersChanged || owner != owners[id];
+            positionHash ^= territoryKey(id, owners[id], armies[id]) ^ territoryKey(id, owner, count);
+            owners[id] = owner;
+            armies[id] = count;
+        }
+    }
+
+    quietTurns = ownersChanged ? 0 : quietTurns + 1;
+    int times = ++seen[positionHash];
+
+    if (rule.window > 0 && quietTurns >= rule.window)
+        reason = "no territory changed hands in " + to_string(quietTurns) + " turns";
+    else if (rule.repeats > 0 && times >= rule.repeats)
+        reason = "same position reached " + to_string(times) + " times";
+    else
+        return false;
+
+    LOG_NOTIFY(PROGRESSION, "Stalemate at turn ", turn, ": ", reason, ". Game ends in a draw.");
+    return true;
+}
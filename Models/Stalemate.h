@@ -0,0 +1,49 @@
+#ifndef STALEMATE_H
+#define STALEMATE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../utils/LoggingObserver.h"
+
+class GameEngine;
+
+// When a game that cannot be won any more is called a draw. Both checks run at the end
+// of each turn; 0 turns a check off (the default: every game runs its full -D turns).
+struct StalemateRule
+{
+    int window = 0;  // draw after this many turns in a row without a territory changing hands
+    int repeats = 0; // draw when the same position (owners and armies) comes back this many times
+
+    bool enabled() const { return window > 0 || repeats > 0; }
+};
+
+// Follows one game turn by turn. Owners and armies are compared with the previous turn's,
+// and only the territories that changed are rehashed (XOR of one key per territory state),
+// so the position hash costs O(changes) to keep and one pass to detect them.
+class StalemateDetector : public Subject, public ILoggable
+{
+public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_ENGINE; }
+    explicit StalemateDetector(const StalemateRule &rule) : rule(rule) {}
+
+    // True once the rule calls the game a draw; getReason() then says why
+    bool endTurn(const GameEngine &engine, int turn);
+    const std::string &getReason() const { return reason; }
+    uint64_t getPositionHash() const { return positionHash; }
+
+private:
+    static uint64_t territoryKey(int id, int owner, int armies);
+
+    StalemateRule rule;
+    int playerCount = -1;    // as of the previous turn; owner slots shift when it drops
+    std::vector<int> owners; // per territory, as of the previous turn (engine slot, NO_PLAYER = none)
+    std::vector<int> armies;
+    uint64_t positionHash = 0;
+    int quietTurns = 0;
+    std::unordered_map<uint64_t, int> seen; // position hash -> times reached
+    std::string reason;
+};
+
+#endif
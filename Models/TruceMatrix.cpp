@@ -0,0 +1,38 @@
+#include "TruceMatrix.h"
+
+using namespace std;
+
+void TruceMatrix::add(int a, int b)
+{
+    if (a < 0 || b < 0 || a >= MAX_SLOTS || b >= MAX_SLOTS)
+        return;
+    bits |= uint64_t(1) << (a * MAX_SLOTS + b);
+    bits |= uint64_t(1) << (b * MAX_SLOTS + a);
+}
+
+void TruceMatrix::removeSlot(int slot)
+{
+    if (slot < 0 || slot >= MAX_SLOTS || bits == 0)
+        return;
+    vector<pair<int, int>> kept = pairs();
+    bits = 0;
+    for (const pair<int, int> &truce : kept)
+    {
+        if (truce.first != slot && truce.second != slot)
+            add(truce.first - (truce.first > slot), truce.second - (truce.second > slot));
+    }
+}
+
+vector<pair<int, int>> TruceMatrix::pairs() const
+{
+    vector<pair<int, int>> truces;
+    for (int a = 0; a < MAX_SLOTS && bits; a++)
+    {
+        for (int b = a; b < MAX_SLOTS; b++)
+        {
+            if (has(a, b))
+                truces.push_back({a, b});
+        }
+    }
+    return truces;
+}
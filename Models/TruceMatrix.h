@@ -0,0 +1,38 @@
+#ifndef TRUCE_MATRIX_H
+#define TRUCE_MATRIX_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// This turn's truces between player slots (the engine's players in list order, then the
+// neutral player, as in GameSnapshot). Games have at most six players plus the neutral
+// one, so the symmetric matrix fits in one 8 x 8 bit word: a check is a shift and a mask,
+// and a new turn clears the word. Slots outside the matrix never have a truce.
+class TruceMatrix
+{
+public:
+    static const int MAX_SLOTS = 8;
+
+    void add(int a, int b);
+    bool has(int a, int b) const
+    {
+        unsigned row = static_cast<unsigned>(a), col = static_cast<unsigned>(b);
+        return ((row | col) < MAX_SLOTS) & static_cast<bool>((bits >> ((row * MAX_SLOTS + col) & 63)) & 1);
+    }
+    void clear() { bits = 0; }
+    bool empty() const { return bits == 0; }
+
+    // The slot left the player list: its truces end and later slots move down by one
+    void removeSlot(int slot);
+
+    // Each truce once, smaller slot first, sorted (snapshots and recordings store these)
+    std::vector<std::pair<int, int>> pairs() const;
+
+    bool operator==(const TruceMatrix &other) const { return bits == other.bits; }
+
+private:
+    uint64_t bits = 0; // bit row * MAX_SLOTS + col, set for both (a, b) and (b, a)
+};
+
+#endif
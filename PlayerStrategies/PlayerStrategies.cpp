@@ -3,9 +3,15 @@
 #include "../Models/Map.h"
 #include "../Models/Orders.h"
 #include "../Models/Cards.h"
+#include "../Models/GameEngine.h"
 #include "../utils/logger.h"
+#include "../utils/WorkStealingPool.h"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <limits>
+#include <thread>
 
 using namespace std;
 
@@ -15,7 +21,8 @@ enum class StrategyName : char
     AGGRESSIVE,
     BENEVOLENT,
     NEUTRAL,
-    CHEATER
+    CHEATER,
+    MCTS
 };
 
 const char *toStringStrategy(StrategyName n)
@@ -32,11 +39,52 @@ const char *toStringStrategy(StrategyName n)
         return "Neutral";
     case StrategyName::CHEATER:
         return "Cheater";
+    case StrategyName::MCTS:
+        return "MCTS";
     default:
         return "Human";
     }
 }
 
+// "MCTS:512:100:4" -> 512 rollouts, 100 ms, 4 threads; missing or bad fields keep their default
+static MCTSConfig parseMCTSConfig(const string &name)
+{
+    MCTSConfig config;
+    int *fields[] = {&config.rollouts, &config.timeLimitMs, &config.threads};
+    size_t start = name.find(':');
+    for (int *field : fields)
+    {
+        if (start == string::npos)
+            break;
+        size_t end = name.find(':', start + 1);
+        string text = name.substr(start + 1, end == string::npos ? string::npos : end - start - 1);
+        char *parsedEnd = nullptr;
+        long value = strtol(text.c_str(), &parsedEnd, 10);
+        if (!text.empty() && *parsedEnd == '\0' && value >= 0 && value <= 1000000)
+            *field = static_cast<int>(value);
+        start = end;
+    }
+    if (config.rollouts < 1)
+        config.rollouts = 1;
+    return config;
+}
+
+PlayerStrategy *createStrategy(const string &name, GameEngine *engine)
+{
+    string mcts = toStringStrategy(StrategyName::MCTS);
+    if (name == mcts || name.compare(0, mcts.size() + 1, mcts + ":") == 0)
+        return new MCTSPlayerStrategy(engine, parseMCTSConfig(name));
+    if (name == toStringStrategy(StrategyName::AGGRESSIVE))
+        return new AggressivePlayerStrategy();
+    if (name == toStringStrategy(StrategyName::BENEVOLENT))
+        return new BenevolentPlayerStrategy();
+    if (name == toStringStrategy(StrategyName::NEUTRAL))
+        return new NeutralPlayerStrategy();
+    if (name == toStringStrategy(StrategyName::CHEATER))
+        return new CheaterPlayerStrategy();
+    return new HumanPlayerStrategy();
+}
+
 // ==================== HUMAN PLAYER STRATEGY ====================
 
 HumanPlayerStrategy::HumanPlayerStrategy() {}
@@ -49,10 +97,8 @@ string HumanPlayerStrategy::getStrategyName() const
 
 bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 {
-    logMessage(INFO, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
-    Notify(this, INFO, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
-    logMessage(INFO, "Reinforcement pool: " + to_string(player->getReinforcementPool()));
-    Notify(this, INFO, "Reinforcement pool: " + to_string(player->getReinforcementPool()));
+    LOG_NOTIFY(INFO, player->getPlayerName(), "'s Turn (", getStrategyName(), " Strategy)");
+    LOG_NOTIFY(INFO, "Reinforcement pool: ", player->getReinforcementPool());
 
     cout << "\nWhat would you like to do?" << endl;
     cout << "1. Deploy armies" << endl;
@@ -79,7 +125,7 @@ bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
         if (choice == 4)
         {
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            logMessage(PROGRESSION, player->getPlayerName() + " Done issuing orders");
+            LOG_MESSAGE(PROGRESSION, player->getPlayerName(), " Done issuing orders");
             Notify(this, PROGRESSION, player->getPlayerName() + " Dsone issuing orders");
             return false; // Done issuing orders
         }
@@ -88,13 +134,13 @@ bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 
         if (choice == 1)
         {
-            vector<Territory *> territories = player->getTerritories();
+            Span<Territory *> territories = player->getTerritories();
             for (size_t i = 0; i < territories.size(); i++)
             {
                 cout << i + 1 << ". " << territories[i]->getName()
                      << " (armies: " << territories[i]->getArmies() << ")" << endl;
             }
-            logMessage(INPUT, "Select territory to deploy to (1 - " + to_string(territories.size()) + "): ");
+            LOG_MESSAGE(INPUT, "Select territory to deploy to (1 - ", territories.size(), "): ");
             int territoryChoice;
             cin >> territoryChoice;
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -104,7 +150,7 @@ bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
                 return true;
             }
 
-            logMessage(INPUT, "How many armies to deploy? (available: " + to_string(player->getReinforcementPool()) + "): ");
+            LOG_MESSAGE(INPUT, "How many armies to deploy? (available: ", player->getReinforcementPool(), "): ");
             int armies;
             cin >> armies;
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -123,7 +169,7 @@ bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
         else if (choice == 2)
         {
             // Advance Order
-            vector<Territory *> territories = player->getTerritories();
+            Span<Territory *> territories = player->getTerritories();
             logMessage(INFO, "Your Territories: ");
             for (size_t i = 0; i < territories.size(); i++)
             {
@@ -140,7 +186,7 @@ bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
                 return true;
             }
             Territory *source = territories[sourceChoice - 1];
-            vector<Territory *> neighbors = map->getNeighborsOf(source);
+            TerritoryRange neighbors = map->neighborsOf(source);
 
             logMessage(INFO, "Neighboring territories");
             for (size_t i = 0; i < neighbors.size(); i++)
@@ -160,7 +206,7 @@ bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
                 return true;
             }
 
-            logMessage(INPUT, "How many armies to advance? (available: " + to_string(source->getArmies()) + ")");
+            LOG_MESSAGE(INPUT, "How many armies to advance? (available: ", source->getArmies(), ")");
             int armies;
             cin >> armies;
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -201,8 +247,7 @@ bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
     }
     catch (const exception &e)
     {
-        logMessage(ERROR, string("Human player did something unexpected: ") + e.what());
-        Notify(this, ERROR, string("Human player did something unexpected: ") + e.what());
+        LOG_NOTIFY(ERROR, "Human player did something unexpected: ", e.what());
         cin.clear();
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
@@ -213,11 +258,11 @@ bool HumanPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 vector<Territory *> HumanPlayerStrategy::toAttack(Player *player, Map *map) const
 {
     vector<Territory *> attackList;
-    vector<Territory *> ownedTerritories = player->getTerritories();
+    Span<Territory *> ownedTerritories = player->getTerritories();
     // Get All adjacent enemy territories;
     for (Territory *territory : ownedTerritories)
     {
-        vector<Territory *> neighbors = map->getNeighborsOf(territory);
+        TerritoryRange neighbors = map->neighborsOf(territory);
         for (Territory *neighbor : neighbors)
         {
             if (!player->ownsTerritoryId(neighbor->getId()))
@@ -236,7 +281,7 @@ vector<Territory *> HumanPlayerStrategy::toAttack(Player *player, Map *map) cons
 
 vector<Territory *> HumanPlayerStrategy::toDefend(Player *player) const
 {
-    return player->getTerritories();
+    return player->getTerritories().toVector();
 }
 
 // ==================== AGGRESSIVE PLAYER STRATEGY ====================
@@ -251,7 +296,7 @@ string AggressivePlayerStrategy::getStrategyName() const
 
 Territory *AggressivePlayerStrategy::getStrongestTerritory(Player *player) const
 {
-    vector<Territory *> territories = player->getTerritories();
+    Span<Territory *> territories = player->getTerritories();
     if (territories.empty())
         return nullptr;
 
@@ -273,8 +318,7 @@ Territory *AggressivePlayerStrategy::getStrongestTerritory(Player *player) const
 
 bool AggressivePlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 {
-    logMessage(AI, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
-    Notify(this, AI, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
+    LOG_NOTIFY(AI, player->getPlayerName(), "'s Turn (", getStrategyName(), " Strategy)");
 
     // First, deploy all reinforcement to strongest territory
     if (player->getReinforcementPool() > 0)
@@ -286,8 +330,7 @@ bool AggressivePlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
             int armies = player->getReinforcementPool();
             player->getOrdersList()->add(new Deploy(player, strongest, armies));
             player->takeFromReinforcement(armies);
-            logMessage(AI, "Deployed " + to_string(armies) + " armies to " + strongest->getName());
-            Notify(this, AI, "Deployed " + to_string(armies) + " armies to " + strongest->getName());
+            LOG_NOTIFY(AI, "Deployed ", armies, " armies to ", strongest->getName());
             return true;
         }
     }
@@ -297,7 +340,7 @@ bool AggressivePlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 
     if (strongest && strongest->getArmies() > 1)
     {
-        vector<Territory *> neighbors = map->getNeighborsOf(strongest);
+        TerritoryRange neighbors = map->neighborsOf(strongest);
         // Find an enemy neighbor
         for (Territory *neighbor : neighbors)
         {
@@ -305,8 +348,7 @@ bool AggressivePlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
             {
                 int armiesToAdvance = strongest->getArmies() - 1;
                 player->getOrdersList()->add(new Advance(player, strongest, neighbor, armiesToAdvance));
-                logMessage(AI, "Advancing " + to_string(armiesToAdvance) + " armies from " + strongest->getName() + " to " + neighbor->getName());
-                Notify(this, AI, "Advancing " + to_string(armiesToAdvance) + " armies from " + strongest->getName() + " to " + neighbor->getName());
+                LOG_NOTIFY(AI, "Advancing ", armiesToAdvance, " armies from ", strongest->getName(), " to ", neighbor->getName());
                 return true;
             }
         }
@@ -321,7 +363,7 @@ vector<Territory *> AggressivePlayerStrategy::toAttack(Player *player, Map *map)
     Territory *strongest = getStrongestTerritory(player);
     if (strongest)
     {
-        vector<Territory *> neighbors = map->getNeighborsOf(strongest);
+        TerritoryRange neighbors = map->neighborsOf(strongest);
         for (Territory *neighbor : neighbors)
         {
             if (!player->ownsTerritoryId(neighbor->getId()))
@@ -357,7 +399,7 @@ string BenevolentPlayerStrategy::getStrategyName() const
 
 Territory *BenevolentPlayerStrategy::getWeakestTerritory(Player *player) const
 {
-    vector<Territory *> territories = player->getTerritories();
+    Span<Territory *> territories = player->getTerritories();
     if (territories.empty())
         return nullptr;
 
@@ -379,8 +421,7 @@ Territory *BenevolentPlayerStrategy::getWeakestTerritory(Player *player) const
 
 bool BenevolentPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 {
-    logMessage(AI, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
-    Notify(this, AI, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
+    LOG_NOTIFY(AI, player->getPlayerName(), "'s Turn (", getStrategyName(), " Strategy)");
 
     // Deploy all reinforcement to weak territory
     if (player->getReinforcementPool() > 0)
@@ -391,13 +432,12 @@ bool BenevolentPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
             int armies = player->getReinforcementPool();
             player->getOrdersList()->add(new Deploy(player, weakest, armies));
             player->takeFromReinforcement(armies);
-            logMessage(AI, "Deployed " + to_string(armies) + " armies to weakest territory: " + weakest->getName());
-            Notify(this, AI, "Deployed " + to_string(armies) + " armies to weakest territory: " + weakest->getName());
+            LOG_NOTIFY(AI, "Deployed ", armies, " armies to weakest territory: ", weakest->getName());
             return true;
         }
     }
     // Advance armies from stronger territories to weaker ones
-    vector<Territory *> territories = player->getTerritories();
+    Span<Territory *> territories = player->getTerritories();
     if (territories.size() > 1)
     {
         Territory *weakest = getWeakestTerritory(player);
@@ -406,7 +446,7 @@ bool BenevolentPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
         {
             if (owned != weakest && owned->getArmies() > weakest->getArmies())
             {
-                vector<Territory *> neighbors = map->getNeighborsOf(owned);
+                TerritoryRange neighbors = map->neighborsOf(owned);
                 for (Territory *neighbor : neighbors)
                 {
                     if (neighbor == weakest)
@@ -415,8 +455,7 @@ bool BenevolentPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
                         if (armiesToMove > 0)
                         {
                             player->getOrdersList()->add(new Advance(player, owned, weakest, armiesToMove));
-                            logMessage(AI, "Moving " + to_string(armiesToMove) + " armies from " + owned->getName() + " to " + weakest->getName());
-                            Notify(this, AI, "Moving " + to_string(armiesToMove) + " armies from " + owned->getName() + " to " + weakest->getName());
+                            LOG_NOTIFY(AI, "Moving ", armiesToMove, " armies from ", owned->getName(), " to ", weakest->getName());
                             return true;
                         }
                     }
@@ -435,7 +474,7 @@ vector<Territory *> BenevolentPlayerStrategy::toAttack(Player *player, Map *map)
 
 vector<Territory *> BenevolentPlayerStrategy::toDefend(Player *player) const
 {
-    vector<Territory *> toDefentList = player->getTerritories();
+    vector<Territory *> toDefentList = player->getTerritories().toVector();
     // sort by army count (weakest territory first)
     std::sort(toDefentList.begin(), toDefentList.end(),
               [](Territory *a, Territory *b)
@@ -458,8 +497,7 @@ string NeutralPlayerStrategy::getStrategyName() const
 
 bool NeutralPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 {
-    logMessage(AI, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
-    Notify(this, AI, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
+    LOG_NOTIFY(AI, player->getPlayerName(), "'s Turn (", getStrategyName(), " Strategy)");
     return false; // never does anything
 }
 
@@ -491,21 +529,8 @@ void CheaterPlayerStrategy::instantConquerCheat(const vector<Territory *> &toCon
 {
     for (Territory *territory : toConquer)
     {
-        // Get old owner and remove territory from their list
-        Player *oldOwner = territory->getOwner();
-        if (oldOwner != nullptr)
-        {
-            oldOwner->removeTerritory(territory);
-        }
-
-        // Set new owner and add to their list
-        territory->setOwner(player);
-
-        // Only add if not already in player's list
-        if (!player->ownsTerritoryId(territory->getId()))
-        {
-            player->addTerritory(territory);
-        }
+        // Remove from the old owner's list, set the new owner and add to their list
+        Player::transferTerritory(territory, player);
     }
 }
 
@@ -522,8 +547,7 @@ void CheaterPlayerStrategy::duplicateReinforcementsCheat(Player *player)
 
 bool CheaterPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 {
-    logMessage(AI, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
-    Notify(this, AI, player->getPlayerName() + "'s Turn (" + getStrategyName() + " Strategy)");
+    LOG_NOTIFY(AI, player->getPlayerName(), "'s Turn (", getStrategyName(), " Strategy)");
     /*
     if (hasConqueredThisTurn)
     {
@@ -536,11 +560,10 @@ bool CheaterPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
     duplicateReinforcementsCheat(player);
     if (currentReinforcement != player->getReinforcementPool())
     {
-        logMessage(ANTICHEAT, "(DUPLICATE REINFORCEMENT, " + to_string(currentReinforcement) + ", " + to_string(player->getReinforcementPool()) + ", " + player->getPlayerName() + ")");
-        Notify(this, ANTICHEAT, "(DUPLICATE REINFORCEMENT, " + to_string(currentReinforcement) + ", " + to_string(player->getReinforcementPool()) + ", " + player->getPlayerName() + ")");
+        LOG_NOTIFY(ANTICHEAT, "(DUPLICATE REINFORCEMENT, ", currentReinforcement, ", ", player->getReinforcementPool(), ", ", player->getPlayerName(), ")");
     }
 
-    vector<Territory *> territories = player->getTerritories();
+    Span<Territory *> territories = player->getTerritories();
     vector<Territory *> toConquer;
 
     for (Territory *territory : territories)
@@ -549,8 +572,7 @@ bool CheaterPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
         infinitArmyCheat(territory);
         if (previousArmi != territory->getArmies())
         {
-            logMessage(ANTICHEAT, "(INFINIT AMMO, " + to_string(previousArmi) + ", " + to_string(territory->getArmies()) + ", " + territory->getName() + ", " + to_string(territory->getId()) + ", " + player->getPlayerName() + ")");
-            Notify(this, ANTICHEAT, "(INFINIT AMMO, " + to_string(previousArmi) + ", " + to_string(territory->getArmies()) + ", " + territory->getName() + ", " + to_string(territory->getId()) + ", " + player->getPlayerName() + ")");
+            LOG_NOTIFY(ANTICHEAT, "(INFINIT AMMO, ", previousArmi, ", ", territory->getArmies(), ", ", territory->getName(), ", ", territory->getId(), ", ", player->getPlayerName(), ")");
         }
     }
 
@@ -560,7 +582,7 @@ bool CheaterPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
 
     for (Territory *territory : territories)
     {
-        vector<Territory *> neighbors = map->getNeighborsOf(territory);
+        TerritoryRange neighbors = map->neighborsOf(territory);
         totalNeighborsChecked += neighbors.size();
 
         for (Territory *neighbor : neighbors)
@@ -576,20 +598,17 @@ bool CheaterPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
         }
     }
 
-    logMessage(AI, player->getPlayerName() + " owns " + to_string(territories.size()) + " territories, checked " + to_string(totalNeighborsChecked) + " neighbors, found " + to_string(enemyNeighborsFound) + " enemy neighbors");
-    Notify(this, AI, player->getPlayerName() + " owns " + to_string(territories.size()) + " territories, checked " + to_string(totalNeighborsChecked) + " neighbors, found " + to_string(enemyNeighborsFound) + " enemy neighbors");
+    LOG_NOTIFY(AI, player->getPlayerName(), " owns ", territories.size(), " territories, checked ", totalNeighborsChecked, " neighbors, found ", enemyNeighborsFound, " enemy neighbors");
 
     // Log territory conquests before actually conquering them
     if (!toConquer.empty())
     {
-        logMessage(ANTICHEAT, "(INSTANT CONQUER, " + to_string(toConquer.size()) + " territories conquered by " + player->getPlayerName() + ")");
-        Notify(this, ANTICHEAT, "(INSTANT CONQUER, " + to_string(toConquer.size()) + " territories conquered by " + player->getPlayerName() + ")");
+        LOG_NOTIFY(ANTICHEAT, "(INSTANT CONQUER, ", toConquer.size(), " territories conquered by ", player->getPlayerName(), ")");
         instantConquerCheat(toConquer, player, map);
     }
     else
     {
-        logMessage(WARNING, player->getPlayerName() + " has no adjacent enemy territories to conquer (owns all neighbors!)");
-        Notify(this, WARNING, player->getPlayerName() + " has no adjacent enemy territories to conquer (owns all neighbors!)");
+        LOG_NOTIFY(WARNING, player->getPlayerName(), " has no adjacent enemy territories to conquer (owns all neighbors!)");
     }
 
     hasConqueredThisTurn = true;
@@ -603,5 +622,358 @@ vector<Territory *> CheaterPlayerStrategy::toAttack(Player *player, Map *map) co
 
 vector<Territory *> CheaterPlayerStrategy::toDefend(Player *player) const
 {
-    return player->getTerritories();
+    return player->getTerritories().toVector();
+}
+
+// ==================== MCTS PLAYER STRATEGY ====================
+
+const int MCTS_MAX_DEPLOY_TARGETS = 6;
+const int MCTS_MAX_ADVANCES = 8;
+const int MCTS_ROLLOUTS_PER_LANE = 4; // per batch; the time limit is checked between batches
+const double MCTS_EXPLORATION = 1.41421356237;
+
+MCTSPlayerStrategy::MCTSPlayerStrategy(GameEngine *engine, const MCTSConfig &config)
+    : engine(engine), config(config), fallback(new AggressivePlayerStrategy()) {}
+
+MCTSPlayerStrategy::~MCTSPlayerStrategy()
+{
+    pool.reset();
+    LogMuteScope mute;
+    for (GameEngine *sim : simulations)
+        delete sim;
+}
+
+string MCTSPlayerStrategy::getStrategyName() const
+{
+    return toStringStrategy(StrategyName::MCTS);
+}
+
+static void applyAction(const MCTSPlayerStrategy::Action &action, Player *player, Map *map, Deck *deck)
+{
+    switch (action.kind)
+    {
+    case MCTSPlayerStrategy::DEPLOY:
+        player->getOrdersList()->add(new Deploy(player, map->getTerritoryById(action.target), action.armies));
+        player->takeFromReinforcement(action.armies);
+        break;
+    case MCTSPlayerStrategy::ADVANCE:
+        player->getOrdersList()->add(new Advance(player, map->getTerritoryById(action.source),
+                                                 map->getTerritoryById(action.target), action.armies));
+        break;
+    case MCTSPlayerStrategy::CARD:
+        player->getHandOfCards()->playCard(action.card, *player, *player->getOrdersList(), *deck);
+        break;
+    case MCTSPlayerStrategy::PASS:
+        break;
+    }
+}
+
+static bool hasEnemyNeighbor(Player *player, Map *map, Territory *territory)
+{
+    for (Territory *neighbor : map->neighborsOf(territory))
+    {
+        if (!player->ownsTerritoryId(neighbor->getId()))
+            return true;
+    }
+    return false;
+}
+
+vector<MCTSPlayerStrategy::Action> MCTSPlayerStrategy::candidateActions(Player *player, Map *map) const
+{
+    vector<Action> candidates;
+    auto byArmies = [](Territory *a, Territory *b)
+    { return a->getArmies() != b->getArmies() ? a->getArmies() > b->getArmies() : a->getId() < b->getId(); };
+
+    // The whole pool goes out in one deploy; the choice is where
+    if (player->getReinforcementPool() > 0)
+    {
+        vector<Territory *> frontier;
+        for (Territory *territory : player->getTerritories())
+        {
+            if (territory->getOwner() == player && hasEnemyNeighbor(player, map, territory))
+                frontier.push_back(territory);
+        }
+        if (frontier.empty())
+            frontier = player->getTerritories().toVector();
+        sort(frontier.begin(), frontier.end(), byArmies);
+        for (size_t i = 0; i < frontier.size() && i < MCTS_MAX_DEPLOY_TARGETS; i++)
+        {
+            Action deploy;
+            deploy.kind = DEPLOY;
+            deploy.target = frontier[i]->getId();
+            deploy.armies = player->getReinforcementPool();
+            candidates.push_back(deploy);
+        }
+        return candidates;
+    }
+
+    // Advances with everything not yet ordered out, most favourable odds first
+    vector<pair<int, Action>> advances;
+    for (Territory *source : player->getTerritories())
+    {
+        int available = source->getArmies() - 1 - committed[source->getId()];
+        if (source->getOwner() != player || available <= 0)
+            continue;
+        for (Territory *target : map->neighborsOf(source))
+        {
+            if (player->ownsTerritoryId(target->getId()))
+                continue;
+            Action advance;
+            advance.kind = ADVANCE;
+            advance.source = source->getId();
+            advance.target = target->getId();
+            advance.armies = available;
+            advances.push_back({available - target->getArmies(), advance});
+        }
+    }
+    stable_sort(advances.begin(), advances.end(), [](const pair<int, Action> &a, const pair<int, Action> &b)
+                { return a.first > b.first; });
+    for (size_t i = 0; i < advances.size() && i < MCTS_MAX_ADVANCES; i++)
+        candidates.push_back(advances[i].second);
+
+    // One candidate per card type in hand
+    Span<Card *> cards = player->getHandOfCards()->getCards();
+    for (size_t i = 0; i < cards.size(); i++)
+    {
+        bool seen = false;
+        for (size_t j = 0; j < i && !seen; j++)
+            seen = cards[j]->getType() == cards[i]->getType();
+        if (seen)
+            continue;
+        Action play;
+        play.kind = CARD;
+        play.card = static_cast<int>(i);
+        candidates.push_back(play);
+    }
+
+    candidates.push_back(Action()); // pass
+    return candidates;
+}
+
+// Forked engines are kept between decisions and rebuilt once players are eliminated
+void MCTSPlayerStrategy::prepareSimulations(size_t lanes)
+{
+    bool fits = simulations.size() == lanes;
+    for (size_t i = 0; fits && i < simulations.size(); i++)
+        fits = simulations[i]->getPlayers().size() == engine->getPlayers().size();
+    if (fits)
+        return;
+
+    LogMuteScope mute;
+    for (GameEngine *sim : simulations)
+        delete sim;
+    simulations.clear();
+    for (size_t i = 0; i < lanes; i++)
+    {
+        GameEngine *sim = engine->fork();
+        // Rollout policy: searching or asking for input inside a rollout is not an option
+        for (Player *twin : sim->getPlayers())
+        {
+            string name = twin->getPlayerStrategyName();
+            if (name == toStringStrategy(StrategyName::MCTS) || name == toStringStrategy(StrategyName::HUMAN))
+                twin->setStrategy(new AggressivePlayerStrategy());
+        }
+        simulations.push_back(sim);
+    }
+}
+
+// Plays one rollout on an engine already restored to the decision point; returns the
+// share of the map the player owns at the end (1 for a win)
+double MCTSPlayerStrategy::rollout(GameEngine *sim, int slot, const Action &action, uint64_t seed, uint64_t stream) const
+{
+    sim->setSeed(seed, stream);
+    GameRngScope rngScope(sim->getRng());
+    Player *self = sim->getPlayers()[slot];
+    Map *map = sim->getMap();
+    Deck scratch; // played cards go back here
+
+    applyAction(action, self, map, &scratch);
+
+    // The rest of this turn is approximated by a fresh issuing round for everyone
+    for (int turn = 0; turn < config.rolloutTurns; turn++)
+    {
+        if (turn > 0)
+            sim->reinforcementPhase();
+        sim->issueOrdersPhase();
+        sim->executeOrdersPhase();
+
+        int alive = 0;
+        for (Player *player : sim->getPlayers())
+            alive += player->getTerritories().empty() ? 0 : 1;
+        if (alive <= 1)
+            break;
+    }
+
+    int territoryCount = map->getTerritoriesSize();
+    if (territoryCount == 0)
+        return 0.0;
+    return static_cast<double>(self->getTerritories().size()) / territoryCount;
+}
+
+// Root-level UCB1 over the candidates; returns the index of the most visited one
+int MCTSPlayerStrategy::search(Player *player, const vector<Action> &candidates)
+{
+    const vector<Player *> &players = engine->getPlayers();
+    int slot = static_cast<int>(find(players.begin(), players.end(), player) - players.begin());
+    if (slot == static_cast<int>(players.size()))
+        return 0;
+
+    size_t lanes = config.threads > 0 ? config.threads : max(1u, thread::hardware_concurrency());
+    lanes = min(lanes, static_cast<size_t>(config.rollouts));
+    prepareSimulations(lanes);
+    if (lanes > 1 && (!pool || pool->size() != lanes))
+        pool.reset(new WorkStealingPool(static_cast<unsigned int>(lanes)));
+
+    GameSnapshot root = engine->snapshot();
+    GameRng probe = root.rng; // rollout seeds come from a copy: the real game's stream is untouched
+    uint64_t seed = probe();
+
+    size_t count = candidates.size();
+    vector<int> visits(count, 0);
+    vector<double> rewards(count, 0.0);
+    auto started = chrono::steady_clock::now();
+    int done = 0;
+
+    while (done < config.rollouts)
+    {
+        int batch = min(config.rollouts - done, static_cast<int>(lanes) * MCTS_ROLLOUTS_PER_LANE);
+
+        // Choose every rollout of the batch up front, counting the ones already
+        // assigned as visits so a batch spreads over the candidates
+        vector<int> chosen(batch);
+        vector<int> pending(count, 0);
+        for (int b = 0; b < batch; b++)
+        {
+            int best = 0;
+            double bestScore = -1.0;
+            double logTotal = log(static_cast<double>(done + b + 1));
+            for (size_t c = 0; c < count; c++)
+            {
+                int n = visits[c] + pending[c];
+                if (n == 0)
+                {
+                    best = static_cast<int>(c);
+                    break;
+                }
+                double mean = visits[c] > 0 ? rewards[c] / visits[c] : 0.5;
+                double score = mean + MCTS_EXPLORATION * sqrt(logTotal / n);
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    best = static_cast<int>(c);
+                }
+            }
+            chosen[b] = best;
+            pending[best]++;
+        }
+
+        vector<double> results(batch, 0.0);
+        auto runLane = [&, batch](size_t lane)
+        {
+            LogMuteScope mute;
+            for (int b = static_cast<int>(lane); b < batch; b += static_cast<int>(lanes))
+            {
+                if (simulations[lane]->restore(root))
+                    results[b] = rollout(simulations[lane], slot, candidates[chosen[b]], seed, done + b);
+            }
+        };
+        if (lanes == 1)
+            runLane(0);
+        else
+        {
+            for (size_t lane = 0; lane < lanes; lane++)
+                pool->submit([&runLane, lane]
+                             { runLane(lane); });
+            pool->waitAll();
+        }
+
+        for (int b = 0; b < batch; b++)
+        {
+            visits[chosen[b]]++;
+            rewards[chosen[b]] += results[b];
+        }
+        done += batch;
+
+        if (config.timeLimitMs > 0 &&
+            chrono::steady_clock::now() - started >= chrono::milliseconds(config.timeLimitMs))
+            break;
+    }
+
+    int best = 0;
+    for (size_t c = 1; c < count; c++)
+    {
+        if (visits[c] > visits[best] ||
+            (visits[c] == visits[best] && rewards[c] > rewards[best]))
+            best = static_cast<int>(c);
+    }
+    LOG_NOTIFY(AI, "MCTS: ", done, " rollouts over ", count, " candidates, best mean reward ",
+               visits[best] > 0 ? rewards[best] / visits[best] : 0.0);
+    return best;
+}
+
+void MCTSPlayerStrategy::endTurn()
+{
+    fill(committed.begin(), committed.end(), 0);
+    ordersThisTurn = 0;
+}
+
+bool MCTSPlayerStrategy::issueOrder(Player *player, Map *map, Deck *deck)
+{
+    if (!engine)
+        return fallback->issueOrder(player, map, deck);
+
+    LOG_NOTIFY(AI, player->getPlayerName(), "'s Turn (", getStrategyName(), " Strategy)");
+
+    if (ordersThisTurn >= config.maxOrdersPerTurn)
+    {
+        endTurn();
+        return false;
+    }
+    if (committed.size() != static_cast<size_t>(map->getTerritoriesSize()))
+        committed.assign(map->getTerritoriesSize(), 0);
+
+    vector<Action> candidates = candidateActions(player, map);
+    int choice = candidates.size() > 1 ? search(player, candidates) : 0;
+    const Action &action = candidates[choice];
+
+    switch (action.kind)
+    {
+    case PASS:
+        endTurn();
+        return false;
+    case DEPLOY:
+        LOG_NOTIFY(AI, "Deployed ", action.armies, " armies to ", map->getTerritoryById(action.target)->getName());
+        break;
+    case ADVANCE:
+        committed[action.source] += action.armies;
+        LOG_NOTIFY(AI, "Advancing ", action.armies, " armies from ", map->getTerritoryById(action.source)->getName(),
+                   " to ", map->getTerritoryById(action.target)->getName());
+        break;
+    case CARD:
+        LOG_NOTIFY(AI, "Playing card: ", CardTypeToString(player->getHandOfCards()->getCards()[action.card]->getType()));
+        break;
+    }
+    applyAction(action, player, map, deck);
+    ordersThisTurn++;
+    return true;
+}
+
+vector<Territory *> MCTSPlayerStrategy::toAttack(Player *player, Map *map) const
+{
+    vector<Territory *> attackList;
+    for (Territory *territory : player->getTerritories())
+    {
+        for (Territory *neighbor : map->neighborsOf(territory))
+        {
+            if (!player->ownsTerritoryId(neighbor->getId()) &&
+                find(attackList.begin(), attackList.end(), neighbor) == attackList.end())
+                attackList.push_back(neighbor);
+        }
+    }
+    return attackList;
+}
+
+vector<Territory *> MCTSPlayerStrategy::toDefend(Player *player) const
+{
+    return player->getTerritories().toVector();
 }
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <memory>
 #include "../utils/LoggingObserver.h"
 using namespace std;
 
@@ -10,10 +11,13 @@ class Player;
 class Territory;
 class Map;
 class Deck;
+class GameEngine;
+class WorkStealingPool;
 
 class PlayerStrategy : public Subject, public ILoggable
 {
 public:
+    SubjectCategory subjectCategory() const override { return SUBJECT_PLAYER; }
     virtual ~PlayerStrategy() = default; // deconstructor
 
     // Player Game Methods
@@ -27,7 +31,7 @@ public:
 };
 
 // Human Player Strategy
-class HumanPlayerStrategy : public PlayerStrategy
+class HumanPlayerStrategy final : public PlayerStrategy
 {
 public:
     HumanPlayerStrategy();
@@ -40,7 +44,7 @@ public:
 };
 
 // Aggressive Player Strategy
-class AggressivePlayerStrategy : public PlayerStrategy
+class AggressivePlayerStrategy final : public PlayerStrategy
 {
 public:
     AggressivePlayerStrategy();
@@ -56,7 +60,7 @@ private:
 };
 
 // Benevolent Player Strategy
-class BenevolentPlayerStrategy : public PlayerStrategy
+class BenevolentPlayerStrategy final : public PlayerStrategy
 {
 public:
     BenevolentPlayerStrategy();
@@ -72,7 +76,7 @@ private:
 };
 
 // Neutral Player Strategy
-class NeutralPlayerStrategy : public PlayerStrategy
+class NeutralPlayerStrategy final : public PlayerStrategy
 {
 public:
     NeutralPlayerStrategy();
@@ -85,7 +89,7 @@ public:
 };
 
 // Cheater Player Strategy
-class CheaterPlayerStrategy : public PlayerStrategy
+class CheaterPlayerStrategy final : public PlayerStrategy
 {
 public:
     CheaterPlayerStrategy();
@@ -103,4 +107,72 @@ private:
     void duplicateReinforcementsCheat(Player *player);
 };
 
+// Search settings for the MCTS strategy
+struct MCTSConfig
+{
+    int rollouts = 256;       // rollout budget per decision
+    int timeLimitMs = 200;    // wall-clock cap per decision; 0 = budget only
+    int threads = 1;          // rollout threads; 0 = one per core (tournament workers already use the cores)
+    int rolloutTurns = 3;     // turns played out after the candidate order
+    int maxOrdersPerTurn = 6; // orders issued before the player passes anyway
+};
+
+// Monte Carlo Tree Search Player Strategy
+// Every order is chosen among a handful of candidates (deploy targets, advances,
+// cards, pass) by UCB1 over rollouts. A rollout restores a snapshot of the real game
+// into a private forked engine, applies the candidate and plays a few turns with
+// Aggressive stand-ins; the reward is the share of the map the player then owns.
+// Rollouts run in batches on a thread pool, one forked engine per lane, and each
+// rollout has its own RNG stream, so a decision is reproducible whenever the
+// budget rather than the time limit ends the search.
+class MCTSPlayerStrategy final : public PlayerStrategy
+{
+public:
+    MCTSPlayerStrategy(GameEngine *engine, const MCTSConfig &config = MCTSConfig());
+    ~MCTSPlayerStrategy() override;
+
+    bool issueOrder(Player *player, Map *map, Deck *deck) override;
+    std::vector<Territory *> toAttack(Player *player, Map *map) const override;
+    std::vector<Territory *> toDefend(Player *player) const override;
+    std::string getStrategyName() const override;
+
+    const MCTSConfig &getConfig() const { return config; }
+
+    enum ActionKind
+    {
+        PASS,
+        DEPLOY,
+        ADVANCE,
+        CARD
+    };
+    struct Action
+    {
+        ActionKind kind = PASS;
+        int source = -1; // territory id
+        int target = -1; // territory id
+        int armies = 0;
+        int card = -1; // hand index
+    };
+
+private:
+    vector<Action> candidateActions(Player *player, Map *map) const;
+    int search(Player *player, const vector<Action> &candidates);
+    double rollout(GameEngine *sim, int slot, const Action &action, uint64_t seed, uint64_t stream) const;
+    void prepareSimulations(size_t lanes);
+    void endTurn();
+
+    GameEngine *engine;
+    MCTSConfig config;
+    unique_ptr<PlayerStrategy> fallback; // used when there is no engine to simulate
+    unique_ptr<WorkStealingPool> pool;
+    vector<GameEngine *> simulations; // one per rollout lane, reused between decisions
+    vector<int> committed;            // armies already ordered out of each territory this turn
+    int ordersThisTurn = 0;
+};
+
+// Strategy for a tournament name ("Aggressive", "Benevolent", "Neutral", "Cheater",
+// "MCTS[:rollouts[:timeLimitMs[:threads]]]"); anything else is Human. MCTS searches
+// through engine; without one it plays like Aggressive.
+PlayerStrategy *createStrategy(const string &name, GameEngine *engine = nullptr);
+
 #endif
\ No newline at end of file
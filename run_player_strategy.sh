@@ -2,7 +2,7 @@ echo "PlayerStrategyDriver"
 echo "=============="
 echo "Compiling PlayerStrategyDriver.cpp..."
 
-if g++ -std=c++17 -fsanitize=address -g -o PlayerStrategyDriver Drivers/PlayerStrategyDriver.cpp Models/*.cpp utils/*.cpp PlayerStrategies/*.cpp; then
+if g++ -std=c++17 -pthread -fsanitize=address -g -o PlayerStrategyDriver Drivers/PlayerStrategyDriver.cpp Models/*.cpp utils/*.cpp PlayerStrategies/*.cpp; then
     echo "Compilation succeeded. Running MainDriver..."
     ./PlayerStrategyDriver || echo "PlayerStrategyDriver exited with non-zero status"
     rm -f PlayerStrategyDriver
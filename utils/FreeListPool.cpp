@@ -0,0 +1,108 @@
+#include "FreeListPool.h"
+#include <new>
+
+namespace
+{
+    const std::size_t GRANULE = 16;
+    const std::size_t CLASSES = FreeListPool::MAX_BLOCK / GRANULE;
+
+    // A free block holds the link to the next one
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    // Trivially destructible, so it stays readable while the thread (or the program) tears
+    // down: objects freed by later destructors see closed and bypass the lists
+    struct ThreadLists
+    {
+        FreeBlock *head[CLASSES];
+        std::size_t count[CLASSES];
+        std::size_t fromHeap;
+        bool armed;  // the flusher is registered for this thread
+        bool closed; // thread exiting: later blocks bypass the lists
+    };
+
+    thread_local ThreadLists lists = {};
+
+    // Empties the lists when the thread exits; registered when the first block is kept
+    struct ListsFlusher
+    {
+        ~ListsFlusher()
+        {
+            lists.closed = true;
+            for (std::size_t c = 0; c < CLASSES; c++)
+            {
+                while (lists.head[c])
+                {
+                    FreeBlock *block = lists.head[c];
+                    lists.head[c] = block->next;
+                    ::operator delete(block);
+                }
+                lists.count[c] = 0;
+            }
+        }
+    };
+
+    thread_local ListsFlusher flusher;
+
+    // Size class c serves sizes up to (c + 1) * GRANULE
+    std::size_t classOf(std::size_t size) { return (size + GRANULE - 1) / GRANULE - 1; }
+}
+
+void *FreeListPool::allocate(std::size_t size)
+{
+    if (size == 0 || size > MAX_BLOCK || lists.closed)
+    {
+        lists.fromHeap++;
+        return ::operator new(size);
+    }
+    std::size_t c = classOf(size);
+    if (FreeBlock *block = lists.head[c])
+    {
+        lists.head[c] = block->next;
+        lists.count[c]--;
+        return block;
+    }
+    lists.fromHeap++;
+    return ::operator new((c + 1) * GRANULE);
+}
+
+void FreeListPool::release(void *block, std::size_t size)
+{
+    if (!block)
+        return;
+    if (size == 0 || size > MAX_BLOCK)
+    {
+        ::operator delete(block);
+        return;
+    }
+    std::size_t c = classOf(size);
+    if (lists.count[c] >= MAX_FREE || lists.closed)
+    {
+        ::operator delete(block);
+        return;
+    }
+    if (!lists.armed)
+    {
+        static_cast<void>(&flusher); // first use constructs it and registers its destructor
+        lists.armed = true;
+    }
+    FreeBlock *freed = static_cast<FreeBlock *>(block);
+    freed->next = lists.head[c];
+    lists.head[c] = freed;
+    lists.count[c]++;
+}
+
+std::size_t FreeListPool::freeBlocks()
+{
+    std::size_t total = 0;
+    for (std::size_t c = 0; c < CLASSES; c++)
+        total += lists.count[c];
+    return total;
+}
+
+std::size_t FreeListPool::heapBlocks()
+{
+    return lists.fromHeap;
+}
@@ -0,0 +1,32 @@
+#ifndef FREE_LIST_POOL_H
+#define FREE_LIST_POOL_H
+
+#include <cstddef>
+
+// Recycles small fixed-size blocks for types that are created and destroyed in bulk
+// (orders: a few per player per turn). Each thread keeps one free list per 16-byte size
+// class; a released block goes on the releasing thread's list, so blocks may cross
+// threads. Lists are capped, and blocks above the cap or larger than MAX_BLOCK go
+// straight back to ::operator delete, as does everything a thread holds when it exits.
+class FreeListPool
+{
+public:
+    static const std::size_t MAX_BLOCK = 256;
+    static const std::size_t MAX_FREE = 4096; // blocks kept per size class and thread
+
+    static void *allocate(std::size_t size);
+    static void release(void *block, std::size_t size);
+
+    // Blocks waiting on this thread's lists (for tests)
+    static std::size_t freeBlocks();
+    // Blocks this thread has had to take from ::operator new (for tests)
+    static std::size_t heapBlocks();
+};
+
+// Class-level operator new and delete drawing from the pool. With a virtual destructor,
+// deleting through a base pointer passes the derived size, so every subclass is served.
+#define USE_FREE_LIST_POOL                                                                    \
+    static void *operator new(std::size_t size) { return FreeListPool::allocate(size); }      \
+    static void operator delete(void *block, std::size_t size) { FreeListPool::release(block, size); }
+
+#endif
@@ -0,0 +1,64 @@
+#include "GameRng.h"
+#include <random>
+
+namespace
+{
+    // splitmix64 step: expands a 64-bit value into well-mixed state words
+    uint64_t splitMix(uint64_t &x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    thread_local GameRng *boundRng = nullptr;
+}
+
+uint64_t randomSeed()
+{
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+}
+
+GameRng::GameRng()
+{
+    reseed(randomSeed());
+}
+
+GameRng::GameRng(uint64_t seed, uint64_t stream)
+{
+    reseed(seed, stream);
+}
+
+void GameRng::reseed(uint64_t seed, uint64_t stream)
+{
+    seedValue = seed;
+    streamValue = stream;
+
+    // Hash seed and stream separately before combining, so nearby streams
+    // (game 1, game 2, ...) do not start from nearby states
+    uint64_t a = seed;
+    uint64_t b = stream ^ 0x632BE59BD9B4E019ULL;
+    uint64_t x = splitMix(a) ^ (splitMix(b) * 0xD1B54A32D192ED03ULL);
+    for (uint64_t &word : state)
+        word = splitMix(x);
+}
+
+GameRng &currentGameRng()
+{
+    if (boundRng)
+        return *boundRng;
+    thread_local GameRng fallback;
+    return fallback;
+}
+
+GameRngScope::GameRngScope(GameRng &rng) : previous(boundRng)
+{
+    boundRng = &rng;
+}
+
+GameRngScope::~GameRngScope()
+{
+    boundRng = previous;
+}
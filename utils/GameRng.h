@@ -0,0 +1,80 @@
+#ifndef GAME_RNG_H
+#define GAME_RNG_H
+
+#include <cstdint>
+#include <limits>
+
+// xoshiro256** generator (Blackman & Vigna): four words of state, a few cycles per draw.
+// Meets UniformRandomBitGenerator, so it works with <random> distributions and std::shuffle.
+// A (seed, stream) pair always produces the same sequence; different streams of one seed
+// start from unrelated states, so every game of a tournament gets its own stream.
+class GameRng
+{
+public:
+    using result_type = uint64_t;
+
+    GameRng(); // random seed, stream 0
+    explicit GameRng(uint64_t seed, uint64_t stream = 0);
+
+    void reseed(uint64_t seed, uint64_t stream = 0);
+    uint64_t getSeed() const { return seedValue; }
+    uint64_t getStream() const { return streamValue; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Same seed, stream and position in the sequence
+    bool operator==(const GameRng &other) const
+    {
+        return state[0] == other.state[0] && state[1] == other.state[1] && state[2] == other.state[2] &&
+               state[3] == other.state[3] && seedValue == other.seedValue && streamValue == other.streamValue;
+    }
+    bool operator!=(const GameRng &other) const { return !(*this == other); }
+
+    // Raw state words, for recordings that must resume the sequence exactly
+    uint64_t stateWord(int index) const { return state[index]; }
+    void setStateWord(int index, uint64_t value) { state[index] = value; }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t state[4];
+    uint64_t seedValue = 0;
+    uint64_t streamValue = 0;
+};
+
+// One read of std::random_device, for runs that were not given a seed
+uint64_t randomSeed();
+
+// RNG of the game running on this thread, as bound by GameEngine.
+// Outside a game it falls back to a per-thread generator with a random seed.
+GameRng &currentGameRng();
+
+// Binds a game's RNG to the current thread until the scope ends (scopes nest)
+class GameRngScope
+{
+public:
+    explicit GameRngScope(GameRng &rng);
+    ~GameRngScope();
+
+    GameRngScope(const GameRngScope &) = delete;
+    GameRngScope &operator=(const GameRngScope &) = delete;
+
+private:
+    GameRng *previous;
+};
+
+#endif
@@ -3,11 +3,14 @@
 #include <string>
 #include <fstream>
 #include <sys/stat.h>
-#include <ctime>   // For timestamp generation
-#include <iomanip> // For formatting the timestamp
-#include <sstream> // For std::ostringstream
+#include <ctime>  // For timestamp generation
+#include <chrono> // For the writer idle wait
+#include <algorithm>
 
 const std::string LOGGER_PATH_FILE = "Logs/gamelog.log";
+const std::size_t LOG_RING_CAPACITY = 16384;              // pending records before producers back off
+const std::size_t LOG_BATCH_LIMIT = 1024;                 // records written per batch
+const std::chrono::milliseconds LOG_WRITER_IDLE_WAIT(5); // writer poll interval when idle
 
 // Static member initialization
 LogObserver *LogObserver::instance = nullptr;
@@ -29,53 +32,202 @@ static void ensureDirectoryExists(const std::string &filepath)
     }
 }
 
-// Subject methods
-Subject::Subject()
+// ObserverRegistry methods
+std::atomic<uint32_t> ObserverRegistry::levelMask{0};
+std::atomic<const ObserverRegistry::Subscriptions *> ObserverRegistry::current{nullptr};
+std::atomic<unsigned> ObserverRegistry::epoch{0};
+std::atomic<int> ObserverRegistry::publishing[2] = {};
+std::vector<std::unique_ptr<const ObserverRegistry::Subscriptions>> ObserverRegistry::retired;
+
+static std::mutex registryLock; // serializes subscription changes
+
+void ObserverRegistry::install(Subscriptions *next)
+{
+    uint32_t levels = 0;
+    for (const Subscription &s : *next)
+        levels |= s.levels;
+    // A thread may still be walking the previous list, so it waits for quiesce
+    const Subscriptions *previous = current.exchange(next);
+    if (previous)
+        retired.emplace_back(previous);
+    levelMask.store(levels, std::memory_order_release);
+}
+
+void ObserverRegistry::subscribe(Observer *o, uint32_t levels, uint32_t categories)
+{
+    if (!o)
+        return;
+    std::lock_guard<std::mutex> guard(registryLock);
+    const Subscriptions *list = current.load(std::memory_order_acquire);
+    Subscriptions *next = list ? new Subscriptions(*list) : new Subscriptions();
+    auto it = std::find_if(next->begin(), next->end(), [o](const Subscription &s)
+                           { return s.observer == o; });
+    if (it != next->end())
+    {
+        it->levels |= levels;
+        it->categories |= categories;
+    }
+    else
+        next->push_back({o, levels, categories});
+    install(next);
+}
+
+void ObserverRegistry::unsubscribe(Observer *o, uint32_t categories)
 {
-    observers = new std::list<Observer *>;
-    // Auto-attach global logger if it exists
-    LogObserver *globalLogger = LogObserver::getInstance();
-    if (globalLogger)
+    std::lock_guard<std::mutex> guard(registryLock);
+    const Subscriptions *list = current.load(std::memory_order_acquire);
+    if (!list)
+        return;
+    Subscriptions *next = new Subscriptions();
+    for (Subscription s : *list)
     {
-        observers->push_back(globalLogger);
+        if (s.observer == o)
+            s.categories &= ~categories;
+        if (s.categories)
+            next->push_back(s);
     }
+    install(next);
 }
 
-Subject::~Subject()
+void ObserverRegistry::publish(const ILoggable *loggable, SubjectCategory category, LogLevel level, const std::string &message)
+{
+    // Counted before the list is loaded, in the current epoch's slot; quiesce drains each
+    // slot in turn while new calls count in the other one, so a steady stream cannot stall it
+    unsigned slot = epoch.load() & 1;
+    publishing[slot].fetch_add(1);
+    const Subscriptions *list = current.load();
+    if (list)
+    {
+        for (const Subscription &s : *list)
+        {
+            if ((s.levels & levelBit(level)) && (s.categories & categoryBit(category)))
+                s.observer->Update(const_cast<ILoggable *>(loggable), level, message);
+        }
+    }
+    publishing[slot].fetch_sub(1, std::memory_order_release);
+}
+
+void ObserverRegistry::quiesce()
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    // Twice: a call that read the epoch before the first flip may count in either slot
+    for (int flip = 0; flip < 2; flip++)
+    {
+        unsigned drained = epoch.fetch_add(1) & 1;
+        while (publishing[drained].load() != 0)
+            std::this_thread::yield();
+    }
+    retired.clear();
+}
+
+// Subject methods
+Subject::Subject()
 {
-    delete observers;
+    LogObserver::getInstance();
 }
 
 void Subject::Attach(Observer *o)
 {
-    observers->push_back(o);
+    ObserverRegistry::subscribe(o, ALL_LOG_LEVELS, categoryBit(subjectCategory()));
 }
 
 void Subject::Detach(Observer *o)
 {
-    observers->remove(o);
+    ObserverRegistry::unsubscribe(o, categoryBit(subjectCategory()));
 }
 
-void Subject::Notify(ILoggable *loggable, LogLevel level, std::string messageType)
+void Subject::Notify(const ILoggable *loggable, LogLevel level, const std::string &messageType) const
 {
-    for (Observer *o : *observers)
-        o->Update(loggable, level, messageType);
+    if (logMutedOnThread || !ObserverRegistry::wants(level))
+        return;
+    ObserverRegistry::publish(loggable, subjectCategory(), level, messageType);
 }
-// Const version of Notify
-void Subject::Notify(const ILoggable *loggable, LogLevel level, std::string messageType) const
+
+void Subject::publishLog(const ILoggable *loggable, LogLevel level, const std::string &message, bool toConsole, bool toObservers) const
+{
+    if (toConsole)
+        logMessage(level, message);
+    if (toObservers)
+        Notify(loggable, level, message);
+}
+
+// LogRecordRing methods
+LogRecordRing::LogRecordRing(std::size_t capacity)
+{
+    std::size_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+    for (std::size_t i = 0; i < size; i++)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool LogRecordRing::tryPush(LogRecord &record)
+{
+    std::size_t pos = tail.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true)
+    {
+        slot = &slots[pos & mask];
+        std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0)
+        {
+            // Slot is free for this position: try to claim it
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false; // writer has not consumed this slot yet: ring is full
+        }
+        else
+        {
+            pos = tail.load(std::memory_order_relaxed); // another producer took it
+        }
+    }
+    slot->record = std::move(record);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogRecordRing::tryPop(LogRecord &record)
 {
-    for (Observer *o : *observers)
-        o->Update(const_cast<ILoggable *>(loggable), level, messageType);
+    Slot &slot = slots[head & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+        return false;
+    record = std::move(slot.record);
+    slot.sequence.store(head + mask + 1, std::memory_order_release);
+    head++;
+    return true;
 }
 
 // LogObserver methods
-LogObserver::LogObserver()
+LogObserver::LogObserver() : ring(LOG_RING_CAPACITY)
 {
     // Ensure the Logs directory exists when observer is created
     ensureDirectoryExists(LOGGER_PATH_FILE);
+    logFile.open(LOGGER_PATH_FILE, std::ios::app);
+    if (!logFile.is_open())
+    {
+        logMessage(ERROR, "Error: could not open: " + LOGGER_PATH_FILE + "\n");
+    }
+    writer = std::thread(&LogObserver::writerLoop, this);
 }
 
-LogObserver::~LogObserver() {}
+LogObserver::~LogObserver()
+{
+    {
+        std::lock_guard<std::mutex> guard(wakeLock);
+        stopping.store(true, std::memory_order_release);
+    }
+    wakeUp.notify_one();
+    if (writer.joinable())
+        writer.join();
+    if (logFile.is_open())
+        logFile.close();
+}
 
 // Singleton methods
 LogObserver *LogObserver::getInstance()
@@ -83,6 +235,7 @@ LogObserver *LogObserver::getInstance()
     if (instance == nullptr)
     {
         instance = new LogObserver();
+        ObserverRegistry::subscribe(instance);
     }
     return instance;
 }
@@ -91,136 +244,124 @@ void LogObserver::destroyInstance()
 {
     if (instance != nullptr)
     {
-        delete instance;
+        ObserverRegistry::unsubscribe(instance);
+        ObserverRegistry::quiesce(); // no thread is still inside Update
+        delete instance;             // flushes everything still queued
         instance = nullptr;
     }
 }
 
-void LogObserver::Update(ILoggable *loggable, LogLevel level, std::string messageType)
+// Convert LogLevel to string
+static const char *levelToString(LogLevel level)
 {
-    // Get the current time
-    std::time_t now = std::time(nullptr);
-    std::tm *localTime = std::localtime(&now);
-
-    // Format the timestamp
-    std::ostringstream timestamp;
-    timestamp << std::put_time(localTime, "%Y-%m-%d %H:%M:%S");
-    std::string color;
-    if (level == DEBUG)
-    {
-        color = CYAN;
-    }
-    else if (level == INFO)
-    {
-        color = GREEN;
-    }
-    else if (level == ERROR)
-    {
-        color = RED;
-    }
-    else if (level == WARNING)
-    {
-        color = YELLOW;
-    }
-    else if (level == ANTICHEAT)
-    {
-        color = MAGENTA;
-    }
-    else if (level == AI)
-    {
-        color = BLUE;
-    }
-    else if (level == INVENTORY)
-    {
-        color = CYAN;
-    }
-    else if (level == COMBAT)
-    {
-        color = RED;
-    }
-    else if (level == PROGRESSION)
-    {
-        color = GREEN;
-    }
-    else if (level == INPUT)
-    {
-        color = GREEN;
-    }
-    else if (level == EVENT)
-    {
-        color = MAGENTA;
-    }
-    else if (level == HUMAN)
-    {
-        color = BLUE;
-    }
-    else
-    {
-        color = RESET;
-    }
-
-    // Convert LogLevel to string
-    std::string levelStr;
     switch (level)
     {
     case DEBUG:
-        levelStr = "DEBUG";
-        break;
+        return "DEBUG";
     case INFO:
-        levelStr = "INFO";
-        break;
+        return "INFO";
     case ERROR:
-        levelStr = "ERROR";
-        break;
+        return "ERROR";
     case WARNING:
-        levelStr = "WARNING";
-        break;
+        return "WARNING";
     case ANTICHEAT:
-        levelStr = "ANTICHEAT";
-        break;
+        return "ANTICHEAT";
     case AI:
-        levelStr = "AI";
-        break;
+        return "AI";
     case HUMAN:
-        levelStr = "HUMAN";
-        break;
+        return "HUMAN";
     case INVENTORY:
-        levelStr = "INVENTORY";
-        break;
+        return "INVENTORY";
     case COMBAT:
-        levelStr = "COMBAT";
-        break;
+        return "COMBAT";
     case PROGRESSION:
-        levelStr = "PROGRESSION";
-        break;
+        return "PROGRESSION";
     case REPLAY:
-        levelStr = "REPLAY";
-        break;
+        return "REPLAY";
     case INPUT:
-        levelStr = "INPUT";
-        break;
+        return "INPUT";
     case EVENT:
-        levelStr = "EVENT";
-        break;
+        return "EVENT";
     default:
-        levelStr = "UNKNOWN";
-        break;
+        return "UNKNOWN";
     }
+}
 
-    // Format the log entry
-    std::ostringstream logEntry;
-    logEntry << "[" << timestamp.str() << "] [" << levelStr << "] " << messageType;
+void LogObserver::Update(ILoggable *, LogLevel level, const std::string &messageType)
+{
+    // Only capture the record here; formatting and disk I/O happen on the writer thread
+    LogRecord record;
+    record.when = std::time(nullptr);
+    record.level = level;
+    record.message = messageType;
 
-    // Write to the log file
-    std::ofstream logFile(LOGGER_PATH_FILE, std::ios::app);
-    if (logFile.is_open())
+    // Ring full: let the writer catch up rather than dropping the line
+    while (!ring.tryPush(record))
     {
-        logFile << logEntry.str() << std::endl;
-        logFile.close();
+        std::this_thread::yield();
     }
-    else
+}
+
+// Formats "[timestamp] [LEVEL] message" onto the batch; the timestamp is rebuilt once per second
+void LogObserver::appendRecord(std::string &batch, const LogRecord &record)
+{
+    if (record.when != cachedSecond)
     {
-        logMessage(ERROR, "Error: could not open: " + LOGGER_PATH_FILE + "\n");
+        std::tm localTime{};
+#ifdef _WIN32
+        localtime_s(&localTime, &record.when);
+#else
+        localtime_r(&record.when, &localTime);
+#endif
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &localTime);
+        cachedTimestamp = buffer;
+        cachedSecond = record.when;
+    }
+
+    batch += '[';
+    batch += cachedTimestamp;
+    batch += "] [";
+    batch += levelToString(record.level);
+    batch += "] ";
+    batch += record.message;
+    batch += '\n';
+}
+
+void LogObserver::writerLoop()
+{
+    std::string batch;
+    LogRecord record;
+
+    while (true)
+    {
+        // Read the flag before draining so nothing queued before shutdown is skipped
+        bool stopRequested = stopping.load(std::memory_order_acquire);
+
+        std::size_t count = 0;
+        while (count < LOG_BATCH_LIMIT && ring.tryPop(record))
+        {
+            appendRecord(batch, record);
+            count++;
+        }
+
+        if (!batch.empty())
+        {
+            if (logFile.is_open())
+            {
+                logFile.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                logFile.flush();
+            }
+            batch.clear();
+            continue;
+        }
+
+        if (stopRequested)
+            return;
+
+        std::unique_lock<std::mutex> lock(wakeLock);
+        wakeUp.wait_for(lock, LOG_WRITER_IDLE_WAIT, [this]
+                        { return stopping.load(std::memory_order_acquire); });
     }
 }
 
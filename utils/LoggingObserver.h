@@ -1,7 +1,14 @@
 #pragma once
 #include <string>
-#include <list>
+#include <vector>
+#include <cstdint>
 #include <fstream>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <ctime>
 #include "logger.h"
 
 // Interface for loggable objects
@@ -15,32 +22,142 @@ public:
 class Observer
 {
 public:
-    virtual void Update(ILoggable *loggable, LogLevel level, std::string messageType) = 0;
+    virtual void Update(ILoggable *loggable, LogLevel level, const std::string &messageType) = 0;
 
     virtual ~Observer() = default;
 };
 
-// Base subject class
-class Subject
+// What a subject is, so an observer can follow only part of the game
+enum SubjectCategory
 {
+    SUBJECT_GENERAL,
+    SUBJECT_ENGINE,  // GameEngine, recording and replay, stalemate and forecasts
+    SUBJECT_MAP,     // Map, MapLoader
+    SUBJECT_ORDER,   // Order, OrdersList
+    SUBJECT_CARD,    // Card, Hand, Deck
+    SUBJECT_PLAYER,  // Player, strategies
+    SUBJECT_COMMAND, // CommandProcessor, Command, FileLineReader
+    SUBJECT_CATEGORY_COUNT
+};
+
+const uint32_t ALL_LOG_LEVELS = ~uint32_t(0);
+const uint32_t ALL_SUBJECTS = (uint32_t(1) << SUBJECT_CATEGORY_COUNT) - 1;
+constexpr uint32_t levelBit(LogLevel level) { return uint32_t(1) << level; }
+constexpr uint32_t categoryBit(SubjectCategory category) { return uint32_t(1) << category; }
+
+// Every observer, with the levels and subject categories it takes. Subjects keep no list
+// of their own: Notify checks one mask of all subscribed levels and returns at once when
+// no one takes the level. Subscribing publishes a new immutable list, so notifying from
+// worker threads needs no lock; replaced lists are kept until quiesce frees them.
+class ObserverRegistry
+{
+public:
+    // Adds levels and categories to what o already takes
+    static void subscribe(Observer *o, uint32_t levels = ALL_LOG_LEVELS, uint32_t categories = ALL_SUBJECTS);
+    // Stops o taking these categories; o is dropped once it takes none
+    static void unsubscribe(Observer *o, uint32_t categories = ALL_SUBJECTS);
+
+    static bool wants(LogLevel level) { return (levelMask.load(std::memory_order_relaxed) >> level) & 1; }
+    static void publish(const ILoggable *loggable, SubjectCategory category, LogLevel level, const std::string &message);
+
+    // Waits for the publish calls in flight, then frees the replaced lists. After it returns
+    // no thread is still calling an observer that was unsubscribed, so it may be deleted.
+    static void quiesce();
+
 private:
-    std::list<Observer *> *observers;
+    struct Subscription
+    {
+        Observer *observer;
+        uint32_t levels;
+        uint32_t categories;
+    };
+    using Subscriptions = std::vector<Subscription>;
+
+    static void install(Subscriptions *next);
+
+    static std::atomic<uint32_t> levelMask;
+    static std::atomic<const Subscriptions *> current;
+    static std::atomic<unsigned> epoch;                               // parity picks the publishing slot
+    static std::atomic<int> publishing[2];                            // publish calls in flight, by epoch parity
+    static std::vector<std::unique_ptr<const Subscriptions>> retired; // guarded by registryLock
+};
 
+// Base subject class
+class Subject
+{
 public:
-    Subject();
-    virtual ~Subject();
+    Subject(); // creates the global logger on first use; it takes everything
+    virtual ~Subject() = default;
+    virtual SubjectCategory subjectCategory() const { return SUBJECT_GENERAL; }
+    // o takes every level from this subject's category (Detach: stops taking it)
     virtual void Attach(Observer *o);
     virtual void Detach(Observer *o);
-    virtual void Notify(ILoggable *loggable, LogLevel level, std::string messageType);
-    virtual void Notify(const ILoggable *loggable, LogLevel level, std::string messageType) const;
+    virtual void Notify(const ILoggable *loggable, LogLevel level, const std::string &messageType) const;
+
+    bool hasObservers(LogLevel level) const { return ObserverRegistry::wants(level); }
+    // Hands one already formatted message to the console and/or the observers
+    void publishLog(const ILoggable *loggable, LogLevel level, const std::string &message, bool toConsole, bool toObservers) const;
+};
+
+// Logging front end for Subject members. The message is formatted once, and only if
+// the console or an observer will take it; both sinks then share the same text.
+// Levels below LOG_COMPILE_FLOOR expand to nothing (see logger.h).
+#define LOG_TO_SINKS(level, toConsole, toObservers, ...)                                       \
+    do                                                                                         \
+    {                                                                                          \
+        if constexpr (logCompiledIn(level))                                                    \
+        {                                                                                      \
+            bool logConsole = (toConsole) && consoleEnabled(level);                            \
+            bool logObservers = (toObservers) && logEnabled(level) && this->hasObservers(level); \
+            if (logConsole || logObservers)                                                    \
+                this->publishLog(this, level, formatLog(__VA_ARGS__), logConsole, logObservers); \
+        }                                                                                      \
+    } while (0)
+
+// Console and observers (replaces a logMessage + Notify pair with the same text)
+#define LOG_NOTIFY(level, ...) LOG_TO_SINKS(level, true, true, __VA_ARGS__)
+// Observers only
+#define LOG_OBSERVERS(level, ...) LOG_TO_SINKS(level, false, true, __VA_ARGS__)
+
+// One pending log line, formatted by the writer thread
+struct LogRecord
+{
+    std::time_t when = 0;
+    LogLevel level = INFO;
+    std::string message;
+};
+
+// Bounded lock-free multi-producer / single-consumer ring buffer of log records.
+// Each slot carries a sequence number telling producers and the consumer whose turn it is.
+class LogRecordRing
+{
+public:
+    explicit LogRecordRing(std::size_t capacity); // rounded up to a power of two
+    LogRecordRing(const LogRecordRing &) = delete;
+    LogRecordRing &operator=(const LogRecordRing &) = delete;
+
+    bool tryPush(LogRecord &record); // false when full (record left untouched)
+    bool tryPop(LogRecord &record);  // single consumer only
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    std::atomic<std::size_t> tail{0}; // next slot producers claim
+    std::size_t head = 0;             // next slot the writer reads
 };
 
 class LogObserver : public Observer
 {
 public:
     LogObserver();
-    ~LogObserver();
-    void Update(ILoggable *loggable, LogLevel level, std::string messageType) override;
+    ~LogObserver(); // drains pending records and closes the log file
+    void Update(ILoggable *loggable, LogLevel level, const std::string &messageType) override;
 
     // Helper method to log messages directly to file
     void logToFile(LogLevel level, const std::string &message);
@@ -51,5 +168,20 @@ public:
 
 private:
     static LogObserver *instance;
+
+    // Background writer: keeps the log file open and appends records in batches
+    void writerLoop();
+    void appendRecord(std::string &batch, const LogRecord &record);
+
+    LogRecordRing ring;
+    std::ofstream logFile;
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+    std::mutex wakeLock;
+    std::condition_variable wakeUp;
+
+    // "%Y-%m-%d %H:%M:%S" for cachedSecond; only touched by the writer thread
+    std::time_t cachedSecond = -1;
+    std::string cachedTimestamp;
 };
 #pragma once
@@ -0,0 +1,52 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &filename)
+{
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            void *addr = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                bytes = static_cast<const char *>(addr);
+                length = static_cast<std::size_t>(info.st_size);
+                mapped = true;
+                opened = true;
+            }
+        }
+        ::close(fd); // the mapping stays valid after close
+        if (opened)
+            return;
+    }
+#endif
+
+    // Fallback: empty files, mmap failures and non-POSIX platforms
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return;
+    fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    bytes = fallback.data();
+    length = fallback.size();
+    opened = true;
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+    if (mapped)
+        ::munmap(const_cast<char *>(bytes), length);
+#endif
+}
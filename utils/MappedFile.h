@@ -0,0 +1,33 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only view of a whole file.
+// Uses mmap on POSIX systems; elsewhere (or if mapping fails) the file is read into memory.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    // Non copyable: owns the mapping
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool isOpen() const { return opened; }
+    const char *data() const { return bytes; }
+    std::size_t size() const { return length; }
+    std::string_view contents() const { return std::string_view(bytes, length); }
+
+private:
+    const char *bytes = nullptr;
+    std::size_t length = 0;
+    bool opened = false;
+    bool mapped = false;   // true when bytes came from mmap
+    std::string fallback; // owns the bytes when the file could not be mapped
+};
+
+#endif
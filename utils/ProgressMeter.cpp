@@ -0,0 +1,69 @@
+#include "ProgressMeter.h"
+#include "logger.h"
+#include <cstdio>
+
+// A terminal redraws in place, so it can update often; a log file gets a line per update
+const long long TERMINAL_REDRAW_MS = 100;
+const long long LOG_REDRAW_MS = 5000;
+
+// "m:ss", or "h:mm:ss" past an hour
+static std::string formatDuration(double seconds)
+{
+    long long total = static_cast<long long>(seconds + 0.5);
+    char buffer[32];
+    if (total >= 3600)
+        std::snprintf(buffer, sizeof(buffer), "%lld:%02lld:%02lld", total / 3600, (total / 60) % 60, total % 60);
+    else
+        std::snprintf(buffer, sizeof(buffer), "%lld:%02lld", total / 60, total % 60);
+    return buffer;
+}
+
+ProgressMeter::ProgressMeter(const std::string &unit, int total)
+    : unit(unit), total(total), start(std::chrono::steady_clock::now()),
+      redrawMillis(consoleIsTerminal() ? TERMINAL_REDRAW_MS : LOG_REDRAW_MS)
+{
+    if (getConsoleMode() == CONSOLE_PROGRESS)
+        logProgress(status(0, 0.0, false));
+}
+
+long long ProgressMeter::elapsedMillis() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ProgressMeter::advance()
+{
+    int completed = done.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (getConsoleMode() != CONSOLE_PROGRESS)
+        return;
+
+    // Only the thread that wins the slot redraws; the others skip the console entirely
+    long long now = elapsedMillis();
+    long long last = lastDrawMillis.load(std::memory_order_relaxed);
+    if (now - last < redrawMillis || !lastDrawMillis.compare_exchange_strong(last, now, std::memory_order_relaxed))
+        return;
+    logProgress(status(completed, now / 1000.0, false));
+}
+
+void ProgressMeter::finish()
+{
+    if (getConsoleMode() == CONSOLE_PROGRESS)
+        logProgress(status(done.load(std::memory_order_relaxed), elapsedMillis() / 1000.0, true));
+    flushConsole();
+}
+
+std::string ProgressMeter::status(int completed, double elapsedSeconds, bool final) const
+{
+    double rate = elapsedSeconds > 0.0 ? completed / elapsedSeconds : 0.0;
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "[PROGRESS] %d/%d %s | %.1f %s/s | ", completed, total, unit.c_str(), rate, unit.c_str());
+
+    std::string line = buffer;
+    if (final)
+        line += "done in " + formatDuration(elapsedSeconds);
+    else if (completed > 0 && rate > 0.0)
+        line += "ETA " + formatDuration((total - completed) / rate);
+    else
+        line += "ETA --:--";
+    return line;
+}
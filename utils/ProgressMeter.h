@@ -0,0 +1,31 @@
+#ifndef PROGRESS_METER_H
+#define PROGRESS_METER_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Counts finished work items for the CONSOLE_PROGRESS status line:
+// "[PROGRESS] 12/40 games | 3.4 games/s | ETA 0:08". Worker threads may call
+// advance() concurrently; redraws are throttled so the console never slows the work.
+class ProgressMeter
+{
+public:
+    ProgressMeter(const std::string &unit, int total);
+
+    void advance(); // one more item done
+    void finish();  // final status with the elapsed time, then flushes the console
+
+private:
+    std::string status(int completed, double elapsedSeconds, bool final) const;
+    long long elapsedMillis() const;
+
+    std::string unit;
+    int total;
+    std::atomic<int> done{0};
+    std::chrono::steady_clock::time_point start;
+    std::atomic<long long> lastDrawMillis{0};
+    long long redrawMillis; // minimum gap between two status updates
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <vector>
+
+// Read-only view over a contiguous array (the part of C++20's std::span we need).
+// Does not own or copy the elements: it is invalidated as soon as the viewed
+// container grows or shrinks, so copy it into a vector before changing the container.
+template <typename T>
+class Span
+{
+public:
+    using value_type = T;
+    using iterator = const T *;
+    using const_iterator = const T *;
+
+    Span() : first(nullptr), count(0) {}
+    Span(const T *data, std::size_t size) : first(data), count(size) {}
+    Span(const std::vector<T> &items) : first(items.data()), count(items.size()) {}
+
+    iterator begin() const { return first; }
+    iterator end() const { return first + count; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T &operator[](std::size_t i) const { return first[i]; }
+    const T &front() const { return first[0]; }
+    const T &back() const { return first[count - 1]; }
+    const T *data() const { return first; }
+
+    std::vector<T> toVector() const { return std::vector<T>(begin(), end()); }
+
+private:
+    const T *first;
+    std::size_t count;
+};
+
+#endif
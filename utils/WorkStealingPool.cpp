@@ -0,0 +1,128 @@
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(unsigned int numThreads)
+{
+    if (numThreads == 0)
+    {
+        numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0)
+            numThreads = 1;
+    }
+
+    for (unsigned int i = 0; i < numThreads; i++)
+        queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (unsigned int i = 0; i < numThreads; i++)
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread &worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+unsigned int WorkStealingPool::size() const
+{
+    return static_cast<unsigned int>(workers.size());
+}
+
+void WorkStealingPool::submit(std::function<void()> task)
+{
+    // Count the task as pending and queued before it becomes visible to the workers,
+    // so it can never finish, or be taken off a queue, before it has been accounted for.
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        pending++;
+        queued++;
+    }
+
+    std::size_t target = nextQueue.fetch_add(1) % queues.size();
+    {
+        std::lock_guard<std::mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    wakeUp.notify_one();
+}
+
+void WorkStealingPool::waitAll()
+{
+    std::unique_lock<std::mutex> lock(stateLock);
+    allDone.wait(lock, [this]
+                 { return pending == 0; });
+
+    if (firstError)
+    {
+        std::exception_ptr error = firstError;
+        firstError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+bool WorkStealingPool::popLocal(std::size_t index, std::function<void()> &task)
+{
+    WorkerQueue &own = *queues[index];
+    std::lock_guard<std::mutex> guard(own.lock);
+    if (own.tasks.empty())
+        return false;
+    task = std::move(own.tasks.back());
+    own.tasks.pop_back();
+    queued--;
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t thief, std::function<void()> &task)
+{
+    for (std::size_t offset = 1; offset < queues.size(); offset++)
+    {
+        WorkerQueue &victim = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.tasks.empty())
+            continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued--;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index)
+{
+    while (true)
+    {
+        std::function<void()> task;
+        if (popLocal(index, task) || steal(index, task))
+        {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard(stateLock);
+                if (!firstError)
+                    firstError = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> guard(stateLock);
+            if (--pending == 0)
+                allDone.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateLock);
+        wakeUp.wait(lock, [this]
+                    { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0)
+            return;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool where every worker owns a task deque.
+// A worker pops its own tasks from the back (LIFO) and, when it runs dry,
+// steals from the front (FIFO) of the other workers' deques.
+class WorkStealingPool
+{
+public:
+    // numThreads == 0 uses std::thread::hardware_concurrency()
+    explicit WorkStealingPool(unsigned int numThreads);
+    ~WorkStealingPool();
+
+    // Non copyable: owns running threads
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    // Queue a task; tasks are spread round-robin over the worker deques
+    void submit(std::function<void()> task);
+
+    // Block until every submitted task has finished.
+    // Rethrows the first exception thrown by a task, if any.
+    void waitAll();
+
+    unsigned int size() const;
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(std::size_t index);
+    bool popLocal(std::size_t index, std::function<void()> &task);
+    bool steal(std::size_t thief, std::function<void()> &task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex stateLock;
+    std::condition_variable wakeUp;  // signalled when work is queued or on shutdown
+    std::condition_variable allDone; // signalled when pending drops to zero
+    std::atomic<std::size_t> queued{0}; // submitted but not yet taken; raised before the push so it never wraps
+    std::size_t pending = 0; // submitted but not finished (guarded by stateLock)
+    bool stopping = false;   // guarded by stateLock
+    std::exception_ptr firstError;
+    std::atomic<std::size_t> nextQueue{0};
+};
+
+#endif
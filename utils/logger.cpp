@@ -1,9 +1,118 @@
 #include "logger.h"
 #include <iostream>
 #include <string>
+#include <mutex>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Tournament games may log from several worker threads; keep lines whole
+static std::mutex consoleLock;
+
+// Quiet modes: lines waiting for flushConsole, written out early once this large
+const std::size_t CONSOLE_BUFFER_LIMIT = 64 * 1024;
+
+std::atomic<int> logMinimumTier{0};
+std::atomic<int> consoleMinimumTier{0};
+thread_local bool logMutedOnThread = false;
+static ConsoleMode consoleMode = CONSOLE_VERBOSE; // guarded by consoleLock
+static std::string pendingOut;                    // guarded by consoleLock
+static std::string pendingErr;                    // guarded by consoleLock
+static bool statusLineShown = false;              // guarded by consoleLock
+
+void setLogLevel(LogLevel minimum)
+{
+    logMinimumTier.store(logTier(minimum), std::memory_order_relaxed);
+}
+
+// Takes the status line off the terminal so normal output starts on a clean line
+static void clearStatusLine()
+{
+    if (!statusLineShown)
+        return;
+    if (consoleIsTerminal())
+        std::cerr << "\r\033[K";
+    statusLineShown = false;
+}
+
+static void writePending()
+{
+    clearStatusLine();
+    if (!pendingOut.empty())
+    {
+        std::cout << pendingOut;
+        std::cout.flush();
+        pendingOut.clear();
+    }
+    if (!pendingErr.empty())
+    {
+        std::cerr << pendingErr;
+        pendingErr.clear();
+    }
+}
+
+void setConsoleMode(ConsoleMode mode)
+{
+    std::lock_guard<std::mutex> guard(consoleLock);
+    if (mode == CONSOLE_VERBOSE)
+        writePending();
+    consoleMode = mode;
+    consoleMinimumTier.store(mode == CONSOLE_VERBOSE ? 0 : logTier(ERROR), std::memory_order_relaxed);
+}
+
+ConsoleMode getConsoleMode()
+{
+    std::lock_guard<std::mutex> guard(consoleLock);
+    return consoleMode;
+}
+
+bool consoleIsTerminal()
+{
+#ifdef _WIN32
+    static const bool terminal = _isatty(_fileno(stderr)) != 0;
+#else
+    static const bool terminal = isatty(fileno(stderr)) != 0;
+#endif
+    return terminal;
+}
+
+void logProgress(const std::string &status)
+{
+    std::lock_guard<std::mutex> guard(consoleLock);
+    if (consoleMode != CONSOLE_PROGRESS)
+        return;
+    // On a terminal the line is redrawn in place; in a CI log each update is its own line
+    if (consoleIsTerminal())
+    {
+        std::cerr << "\r\033[K" << status;
+        std::cerr.flush();
+        statusLineShown = true;
+    }
+    else
+    {
+        std::cerr << status << '\n';
+    }
+}
+
+void flushConsole()
+{
+    std::lock_guard<std::mutex> guard(consoleLock);
+    if (statusLineShown)
+    {
+        std::cerr << '\n'; // keep the last status on screen
+        statusLineShown = false;
+    }
+    writePending();
+}
 
 void logMessage(LogLevel level, const std::string &message)
 {
+    if (!consoleEnabled(level))
+        return;
+
     std::string color;
     std::string prefix;
 
@@ -79,6 +188,15 @@ void logMessage(LogLevel level, const std::string &message)
     }
 
     // Print to stdout except for ERROR
+    std::lock_guard<std::mutex> guard(consoleLock);
+    if (consoleMode != CONSOLE_VERBOSE)
+    {
+        std::string &pending = level == ERROR ? pendingErr : pendingOut;
+        pending += color + prefix + RESET + " " + message + "\n";
+        if (pendingOut.size() + pendingErr.size() >= CONSOLE_BUFFER_LIMIT)
+            writePending();
+        return;
+    }
     if (level == ERROR)
         std::cerr << color << prefix << RESET << " " << message << std::endl;
     else
@@ -2,6 +2,9 @@
 #define LOGGER_H
 
 #include <string>
+#include <atomic>
+#include <string_view>
+#include <type_traits>
 
 // ANSI color codes
 const std::string RESET = "\033[0m";
@@ -30,6 +33,108 @@ enum LogLevel
 
 };
 
+// Filtering tiers, lowest first: 0 trace (DEBUG), 1 chatter (AI, INVENTORY),
+// 2 game events, 3 warnings and cheats, 4 errors
+constexpr int logTier(LogLevel level)
+{
+    switch (level)
+    {
+    case DEBUG:
+        return 0;
+    case AI:
+    case INVENTORY:
+        return 1;
+    case WARNING:
+    case ANTICHEAT:
+        return 3;
+    case ERROR:
+        return 4;
+    default:
+        return 2;
+    }
+}
+
+// Compile-time floor: LOG_* macro calls in a lower tier expand to nothing,
+// arguments included (e.g. -DLOG_COMPILE_FLOOR=2 drops DEBUG, AI and INVENTORY)
+#ifndef LOG_COMPILE_FLOOR
+#define LOG_COMPILE_FLOOR 0
+#endif
+
+constexpr bool logCompiledIn(LogLevel level) { return logTier(level) >= LOG_COMPILE_FLOOR; }
+
+// Runtime minimum, applied on top of the floor by every LOG_* macro
+extern std::atomic<int> logMinimumTier;
+void setLogLevel(LogLevel minimum); // drops every level in a lower tier than minimum
+
+// Set while a thread plays throwaway simulations (MCTS rollouts): nothing it logs
+// reaches the console or the observers
+extern thread_local bool logMutedOnThread;
+inline bool logEnabled(LogLevel level)
+{
+    return !logMutedOnThread && logTier(level) >= logMinimumTier.load(std::memory_order_relaxed);
+}
+
+class LogMuteScope
+{
+public:
+    LogMuteScope() : previous(logMutedOnThread) { logMutedOnThread = true; }
+    ~LogMuteScope() { logMutedOnThread = previous; }
+    LogMuteScope(const LogMuteScope &) = delete;
+    LogMuteScope &operator=(const LogMuteScope &) = delete;
+
+private:
+    bool previous;
+};
+
+// Console output mode. VERBOSE prints every enabled line as it happens; QUIET keeps
+// only errors and buffers them until flushConsole(); PROGRESS is QUIET plus a live
+// status line (see ProgressMeter). Observers still receive every enabled level.
+enum ConsoleMode
+{
+    CONSOLE_VERBOSE,
+    CONSOLE_QUIET,
+    CONSOLE_PROGRESS
+};
+
+extern std::atomic<int> consoleMinimumTier;
+void setConsoleMode(ConsoleMode mode);
+ConsoleMode getConsoleMode();
+inline bool consoleEnabled(LogLevel level)
+{
+    return logEnabled(level) && logTier(level) >= consoleMinimumTier.load(std::memory_order_relaxed);
+}
+bool consoleIsTerminal();                    // stderr is a terminal, so the status line can be redrawn in place
+void logProgress(const std::string &status); // redraws the status line (PROGRESS mode only)
+void flushConsole();                         // ends the status line and writes out buffered lines
+
+// Message building for the LOG_* macros: strings are appended, numbers go through
+// std::to_string, so callers pass raw values instead of preformatting them
+inline void appendLogPart(std::string &out, const std::string &part) { out += part; }
+inline void appendLogPart(std::string &out, std::string_view part) { out += part; }
+inline void appendLogPart(std::string &out, const char *part) { out += part; }
+inline void appendLogPart(std::string &out, char part) { out += part; }
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+void appendLogPart(std::string &out, T part) { out += std::to_string(part); }
+
+template <typename... Parts>
+std::string formatLog(const Parts &...parts)
+{
+    std::string out;
+    (appendLogPart(out, parts), ...);
+    return out;
+}
+
 void logMessage(LogLevel level, const std::string &message);
 
+// Console only; the message is formatted only when the level is enabled
+#define LOG_MESSAGE(level, ...)                                \
+    do                                                         \
+    {                                                          \
+        if constexpr (logCompiledIn(level))                    \
+        {                                                      \
+            if (consoleEnabled(level))                         \
+                logMessage(level, formatLog(__VA_ARGS__));     \
+        }                                                      \
+    } while (0)
+
 #endif
\ No newline at end of file